@@ -0,0 +1,91 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "polynomial.h"
+#include "polynomial_set.h"
+#include "algebra_io.h"
+#include "orders.h"
+#include "f4.h"
+#include "modular_elimination.h"
+#include "speed_tests.h"
+#include "stopwatch.h"
+
+using std::cout;
+using std::cerr;
+
+using namespace SALIB;
+
+// Usage:
+//   elimination_benchmark dump <ideal file> <output prefix>
+//       runs F4 over GF(32003) in DegRevLex on an ideal in the read_polyset format
+//       and writes every Macaulay matrix to <output prefix><index>.txt
+//   elimination_benchmark run <max threads> <matrix files...>
+//       reduces every matrix with the generic elimination and with the modular engine
+
+using CoefType = Field<32003>;
+using Order = CustomOrder<MonoGradientSemiOrder, RevOrder<MonoLexOrder>>;
+using Matrix = SparseMatrix<CoefType>;
+
+int dump_matrices(const std::string& ideal_filename, const std::string& prefix) {
+    std::ifstream in(ideal_filename);
+    if (!in) {
+        cerr << "Can not open " << ideal_filename << "\n";
+        return 1;
+    }
+    PolynomialSet<CoefType, Order> ideal = SpeedTest::read_polyset<CoefType, Order>(in);
+    std::vector<Polynomial<CoefType, Order>> basis(ideal.begin(), ideal.end());
+    size_t dumped = 0;
+    F4Alg<CoefType, Order>::make_groebner_basis(basis, PairSelectionStrategy::DEGREE_SUGAR,
+        [&prefix, &dumped](const Matrix& matrix) {
+            std::ofstream out(prefix + std::to_string(dumped++) + ".txt");
+            matrix.write(out);
+        });
+    cerr << "Dumped " << dumped << " matrices, basis size " << basis.size() << "\n";
+    return 0;
+}
+
+int run_benchmark(size_t max_threads, const std::vector<std::string>& filenames) {
+    cout << "matrix,rows,columns,method,threads,rank,dense_rows,dense_columns,seconds\n";
+    for (const auto& filename : filenames) {
+        std::ifstream in(filename);
+        if (!in) {
+            cerr << "Can not open " << filename << "\n";
+            return 1;
+        }
+        const Matrix matrix = Matrix::read(in);
+
+        Matrix generic = matrix;
+        StopWatch generic_watch;
+        generic.row_echelon_form();
+        double generic_time = generic_watch.get_duration();
+        cout << filename << "," << matrix.rows_count() << "," << matrix.columns_count() << ",generic,1,"
+             << generic.rows_count() << ",,," << generic_time << "\n";
+
+        for (size_t threads_count = 1; threads_count <= max_threads; threads_count *= 2) {
+            Matrix echelon = matrix;
+            StopWatch watch;
+            EliminationStatistics statistics = ModularElimination<32003>::row_echelon_form(echelon, threads_count);
+            double time = watch.get_duration();
+            if (statistics.rank != generic.rows_count())
+                cerr << "Rank mismatch on " << filename << "\n";
+            cout << filename << "," << matrix.rows_count() << "," << matrix.columns_count() << ",modular,"
+                 << threads_count << "," << statistics.rank << "," << statistics.dense_rows << ","
+                 << statistics.dense_columns << "," << time << "\n";
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    std::string mode = argc > 1 ? argv[1] : "";
+    if (mode == "dump" && argc == 4)
+        return dump_matrices(argv[2], argv[3]);
+    if (mode == "run" && argc > 3)
+        return run_benchmark(std::stoul(argv[2]), std::vector<std::string>(argv + 3, argv + argc));
+    cerr << "Usage:\n"
+         << "  " << argv[0] << " dump <ideal file> <output prefix>\n"
+         << "  " << argv[0] << " run <max threads> <matrix files...>\n";
+    return 1;
+}
@@ -0,0 +1,206 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <sstream>
+
+#include "monomial.h"
+#include "polynomial.h"
+#include "polynomial_set.h"
+#include "orders.h"
+#include "field.h"
+#include "algorithms.h"
+#include "stopwatch.h"
+
+using std::cout;
+using std::cerr;
+
+using namespace SALIB;
+
+// Usage:
+//   primitives_benchmark [variables] [degree] [terms] [seconds]
+//       every parameter but seconds may be a comma separated list, all combinations are run.
+//       Defaults: 6 5 20 0.2. One CSV line per primitive and parameters, ns_per_op is the mean time
+//       of one call. Inputs come from a fixed seed, so runs of different builds are comparable.
+
+using CoefType = Field<32003>;
+using Lex = MonoLexOrder;
+using DegLex = CustomOrder<MonoGradientSemiOrder, MonoLexOrder>;
+using DegRevLex = CustomOrder<MonoGradientSemiOrder, RevOrder<MonoLexOrder>>;
+
+// Number of inputs of every kind, a batch calls the operation once on each
+const size_t POOL_SIZE = 64;
+
+// Results are summed here so the compiler can not drop the measured calls
+volatile size_t sink = 0;
+
+struct Parameters {
+    size_t variables;
+    size_t degree;
+    size_t terms;
+    double seconds;
+};
+
+void print_result(const std::string& benchmark, const std::string& order, const Parameters& parameters,
+                  size_t iterations, double seconds) {
+    cout << benchmark << "," << order << "," << parameters.variables << "," << parameters.degree << ","
+         << parameters.terms << "," << iterations << "," << seconds / iterations * 1e9 << "\n";
+}
+
+// Calls operation(0), ..., operation(POOL_SIZE - 1) until the time is spent, prepare() runs untimed before each batch
+template <typename Prepare, typename Operation>
+void measure(const std::string& benchmark, const std::string& order, const Parameters& parameters,
+             Prepare prepare, Operation operation) {
+    size_t iterations = 0;
+    double seconds = 0;
+    while (seconds < parameters.seconds) {
+        prepare();
+        StopWatch watch;
+        for (size_t idx = 0; idx < POOL_SIZE; ++idx)
+            operation(idx);
+        seconds += watch.get_duration();
+        iterations += POOL_SIZE;
+    }
+    print_result(benchmark, order, parameters, iterations, seconds);
+}
+
+template <typename Operation>
+void measure(const std::string& benchmark, const std::string& order, const Parameters& parameters,
+             Operation operation) {
+    measure(benchmark, order, parameters, []() {}, operation);
+}
+
+// Total degree is uniform in [0, degree], the degree is spread over random variables
+Monomial random_monomial(std::mt19937& random, const Parameters& parameters) {
+    std::vector<Monomial::VariableDegreeType> degrees(parameters.variables);
+    size_t degree = std::uniform_int_distribution<size_t>(0, parameters.degree)(random);
+    std::uniform_int_distribution<size_t> variable(0, parameters.variables - 1);
+    for (size_t idx = 0; idx < degree; ++idx)
+        ++degrees[variable(random)];
+    Monomial res;
+    for (size_t var = 0; var < degrees.size(); ++var)
+        res.set_var_degree(var, degrees[var]);
+    return res;
+}
+
+template <typename Order>
+Polynomial<CoefType, Order> random_polynomial(std::mt19937& random, const Parameters& parameters, size_t terms) {
+    std::uniform_int_distribution<unsigned long long> coefficient(1, 32002);
+    std::vector<typename Polynomial<CoefType, Order>::Term> res;
+    for (size_t idx = 0; idx < terms; ++idx)
+        res.emplace_back(random_monomial(random, parameters), CoefType(coefficient(random)));
+    return Polynomial<CoefType, Order>::from_terms(std::move(res));
+}
+
+std::vector<Monomial> random_monomials(std::mt19937& random, const Parameters& parameters) {
+    std::vector<Monomial> res;
+    for (size_t idx = 0; idx < POOL_SIZE; ++idx)
+        res.push_back(random_monomial(random, parameters));
+    return res;
+}
+
+void run_monomial_benchmarks(const Parameters& parameters) {
+    std::mt19937 random(1);
+    const std::vector<Monomial> a = random_monomials(random, parameters);
+    const std::vector<Monomial> b = random_monomials(random, parameters);
+    std::vector<Monomial> products;
+    for (size_t idx = 0; idx < POOL_SIZE; ++idx)
+        products.push_back(a[idx] * b[idx]);
+
+    measure("monomial_multiply", "", parameters, [&](size_t idx) {
+        sink += (a[idx] * b[idx]).get_degree();
+    });
+    measure("monomial_divide", "", parameters, [&](size_t idx) {
+        sink += (products[idx] / b[idx]).get_degree();
+    });
+    measure("monomial_lcm", "", parameters, [&](size_t idx) {
+        sink += Monomial::lcm(a[idx], b[idx]).get_degree();
+    });
+    // Half of the pairs are divisible, so the branch is not predicted for free
+    measure("monomial_is_dividable_by", "", parameters, [&](size_t idx) {
+        sink += (idx % 2 ? products[idx] : a[idx]).is_dividable_by(b[idx]);
+    });
+}
+
+template <typename Order>
+void run_order_benchmarks(const std::string& order, const Parameters& parameters) {
+    using Poly = Polynomial<CoefType, Order>;
+    using Alg = PolyAlg<CoefType, Order>;
+    std::mt19937 random(2);
+    const std::vector<Monomial> a = random_monomials(random, parameters);
+    const std::vector<Monomial> b = random_monomials(random, parameters);
+    std::vector<Poly> p, q, dividers, divisors;
+    for (size_t idx = 0; idx < POOL_SIZE; ++idx) {
+        p.push_back(random_polynomial<Order>(random, parameters, parameters.terms));
+        q.push_back(random_polynomial<Order>(random, parameters, parameters.terms));
+        // A few leading terms of the divider are reduced before the first failure
+        divisors.push_back(random_polynomial<Order>(random, parameters, parameters.terms));
+        dividers.push_back(random_polynomial<Order>(random, parameters, 3) * divisors.back() +
+                           random_polynomial<Order>(random, parameters, parameters.terms));
+    }
+
+    measure("order_cmp", order, parameters, [&](size_t idx) {
+        sink += Order::cmp(a[idx], b[idx]) + 1;
+    });
+    measure("polynomial_add", order, parameters, [&](size_t idx) {
+        sink += (p[idx] + q[idx]).is_zero();
+    });
+    measure("polynomial_multiply", order, parameters, [&](size_t idx) {
+        sink += (p[idx] * q[idx]).is_zero();
+    });
+    measure("s_polynomial", order, parameters, [&](size_t idx) {
+        sink += Poly::s_polynomial(p[idx], q[idx]).is_zero();
+    });
+    std::vector<Poly> reduced;
+    measure("reduce_by_one", order, parameters, [&]() {
+        reduced = dividers;
+    }, [&](size_t idx) {
+        sink += Alg::reduce_by_one(reduced[idx], divisors[idx]);
+    });
+    PolynomialSet<CoefType, Order> set;
+    measure("polynomial_set_add", order, parameters, [&]() {
+        set.clear();
+    }, [&](size_t idx) {
+        set.add(p[idx]);
+    });
+    sink += set.size();
+}
+
+std::vector<size_t> parse_list(const std::string& text) {
+    std::vector<size_t> res;
+    std::istringstream in(text);
+    std::string item;
+    while (std::getline(in, item, ','))
+        res.push_back(std::stoul(item));
+    return res;
+}
+
+int main(int argc, char** argv) {
+    std::vector<size_t> variables = parse_list(argc > 1 ? argv[1] : "6");
+    std::vector<size_t> degrees = parse_list(argc > 2 ? argv[2] : "5");
+    std::vector<size_t> terms = parse_list(argc > 3 ? argv[3] : "20");
+    double seconds = argc > 4 ? std::stod(argv[4]) : 0.2;
+    if (argc > 5) {
+        cerr << "Usage:\n"
+             << "  " << argv[0] << " [variables] [degree] [terms] [seconds]\n";
+        return 1;
+    }
+
+    cout << "benchmark,order,variables,degree,terms,iterations,ns_per_op\n";
+    for (size_t variables_count : variables) {
+        for (size_t degree : degrees) {
+            for (size_t terms_count : terms) {
+                if (variables_count == 0 || terms_count == 0) {
+                    cerr << "Variables and terms must be positive\n";
+                    return 1;
+                }
+                Parameters parameters = {variables_count, degree, terms_count, seconds};
+                run_monomial_benchmarks(parameters);
+                run_order_benchmarks<Lex>("lex", parameters);
+                run_order_benchmarks<DegLex>("deglex", parameters);
+                run_order_benchmarks<DegRevLex>("degrevlex", parameters);
+            }
+        }
+    }
+    return 0;
+}
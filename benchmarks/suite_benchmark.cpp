@@ -0,0 +1,322 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <tuple>
+#include <algorithm>
+#include <cmath>
+
+#include "polynomial.h"
+#include "polynomial_set.h"
+#include "orders.h"
+#include "field.h"
+#include "maple_reader.h"
+#include "computation_context.h"
+#include "memory_accounting.h"
+#include "speed_tests.h"
+#include "stopwatch.h"
+
+using std::cout;
+using std::cerr;
+
+using namespace SALIB;
+
+// Usage:
+//   suite_benchmark [options] <suite file>
+//       runs every system of a file in the tests.txt format under every order and algorithm, one run at a time
+//       in this process, and prints one JSON object with a result per line. Options:
+//         --orders lex,deglex,degrevlex      --algorithms buchberger,f4,...    --strategy normal
+//         --systems name,...                 --warmups 1    --repetitions 5    --timeout 60 (seconds)
+//         --threads 1                        --baseline <previous output>      --tolerance 0.1
+//       Coefficients are taken modulo 32003. Only the Buchberger algorithm is stopped at the timeout, a run of
+//       another algorithm is marked as timed out after it ends. With a baseline every result gets the ratio
+//       of its median to the baseline median, the exit code is 2 if a ratio exceeds 1 + tolerance.
+//       Builds with SALIB_MEMORY_ACCOUNTING add the allocation counters of the last run.
+
+using CoefType = Field<32003>;
+using InputOrder = MonoLexOrder;
+using InputSystem = MapleSystem<CoefType, InputOrder>;
+
+struct Options {
+    std::vector<std::string> orders = {"lex", "deglex", "degrevlex"};
+    std::vector<std::string> algorithms = {"buchberger"};
+    std::vector<std::string> systems;
+    PairSelectionStrategy strategy = PairSelectionStrategy::NORMAL;
+    size_t warmups = 1;
+    size_t repetitions = 5;
+    double timeout = 60;
+    size_t threads_count = 1;
+    std::string baseline;
+    double tolerance = 0.1;
+    std::string suite;
+};
+
+struct RunResult {
+    ComputationStatus status;
+    double seconds;
+    size_t peak_memory;
+    size_t basis_size;
+};
+
+struct Result {
+    std::string system;
+    std::string order;
+    std::string algorithm;
+    ComputationStatus status = ComputationStatus::COMPLETE;
+    size_t basis_size = 0;
+    std::vector<double> seconds;
+    size_t peak_memory = 0;
+};
+
+using ResultKey = std::tuple<std::string, std::string, std::string>;
+
+std::vector<std::string> split_list(const std::string& text) {
+    std::vector<std::string> res;
+    std::istringstream in(text);
+    std::string item;
+    while (std::getline(in, item, ','))
+        res.push_back(item);
+    return res;
+}
+
+bool parse_options(int argc, char** argv, Options& options) {
+    for (int idx = 1; idx < argc; ++idx) {
+        std::string arg = argv[idx];
+        if (arg.compare(0, 2, "--") != 0) {
+            if (!options.suite.empty())
+                return false;
+            options.suite = arg;
+            continue;
+        }
+        if (idx + 1 == argc)
+            return false;
+        std::string value = argv[++idx];
+        if (arg == "--orders")
+            options.orders = split_list(value);
+        else if (arg == "--algorithms")
+            options.algorithms = split_list(value);
+        else if (arg == "--systems")
+            options.systems = split_list(value);
+        else if (arg == "--strategy") {
+            if (!parse_pair_selection_strategy(value, options.strategy))
+                return false;
+        } else if (arg == "--warmups")
+            options.warmups = std::stoul(value);
+        else if (arg == "--repetitions")
+            options.repetitions = std::stoul(value);
+        else if (arg == "--timeout")
+            options.timeout = std::stod(value);
+        else if (arg == "--threads")
+            options.threads_count = std::stoul(value);
+        else if (arg == "--baseline")
+            options.baseline = value;
+        else if (arg == "--tolerance")
+            options.tolerance = std::stod(value);
+        else
+            return false;
+    }
+    return !options.suite.empty() && options.repetitions > 0;
+}
+
+template <typename Order>
+RunResult run_once(const InputSystem& system, SpeedTest::BasisAlgorithm algorithm, const Options& options) {
+    PolynomialSet<CoefType, Order> ideal;
+    for (const auto& poly : system.polynomials)
+        ideal.add(Polynomial<CoefType, Order>(poly));
+    ComputationContext::reset_peak_resident_memory();
+    MemoryAccounting::reset();
+    ComputationContext context;
+    context.set_time_limit(options.timeout);
+    StopWatch watch;
+    auto basis = SpeedTest::calc_basis_and_reduce(ideal, options.strategy, algorithm, options.threads_count,
+                                                  nullptr, &context);
+    double seconds = watch.get_duration();
+    ComputationStatus status = context.get_status();
+    if (status == ComputationStatus::RUNNING)
+        status = ComputationStatus::COMPLETE;
+    if (status == ComputationStatus::COMPLETE && seconds > options.timeout)
+        status = ComputationStatus::TIME_LIMIT;
+    return RunResult{status, seconds, ComputationContext::get_peak_resident_memory(), basis.size()};
+}
+
+template <typename Order>
+Result run_system(const InputSystem& system, const std::string& order, const std::string& algorithm_name,
+                  SpeedTest::BasisAlgorithm algorithm, const Options& options) {
+    Result res;
+    res.system = system.name;
+    res.order = order;
+    res.algorithm = algorithm_name;
+    // A timed out warmup is not repeated, the other runs would time out as well
+    for (size_t idx = 0; idx < options.warmups + options.repetitions; ++idx) {
+        RunResult run = run_once<Order>(system, algorithm, options);
+        res.status = run.status;
+        res.basis_size = run.basis_size;
+        if (run.status != ComputationStatus::COMPLETE)
+            break;
+        if (idx >= options.warmups) {
+            res.seconds.push_back(run.seconds);
+            res.peak_memory = std::max(res.peak_memory, run.peak_memory);
+        }
+    }
+    return res;
+}
+
+double get_median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    size_t middle = values.size() / 2;
+    return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+}
+
+double get_stddev(const std::vector<double>& values) {
+    double mean = 0;
+    for (double value : values)
+        mean += value;
+    mean /= values.size();
+    double squares = 0;
+    for (double value : values)
+        squares += (value - mean) * (value - mean);
+    return std::sqrt(squares / values.size());
+}
+
+// A baseline is an earlier output of this program, every result line is read on its own
+std::string find_field(const std::string& line, const std::string& key) {
+    std::string pattern = "\"" + key + "\": ";
+    size_t start = line.find(pattern);
+    if (start == std::string::npos)
+        return "";
+    start += pattern.size();
+    if (line[start] == '"')
+        return line.substr(start + 1, line.find('"', start + 1) - start - 1);
+    return line.substr(start, line.find_first_of(",}", start) - start);
+}
+
+bool read_baseline(const std::string& filename, std::map<ResultKey, double>& medians) {
+    std::ifstream in(filename);
+    if (!in)
+        return false;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::string median = find_field(line, "median");
+        if (median.empty())
+            continue;
+        medians[ResultKey(find_field(line, "system"), find_field(line, "order"), find_field(line, "algorithm"))] =
+            std::stod(median);
+    }
+    return true;
+}
+
+// Returns true if the result is slower than the baseline beyond the tolerance
+bool write_result(std::ostream& out, const Result& result, const std::map<ResultKey, double>& baseline,
+                  double tolerance) {
+    out << "{\"system\": \"" << result.system << "\", \"order\": \"" << result.order
+        << "\", \"algorithm\": \"" << result.algorithm << "\", \"status\": \"" << to_string(result.status)
+        << "\", \"basis_size\": " << result.basis_size << ", \"runs\": " << result.seconds.size();
+    if (result.status != ComputationStatus::COMPLETE || result.seconds.empty()) {
+        out << "}";
+        return false;
+    }
+    double median = get_median(result.seconds);
+    out << ", \"median\": " << median
+        << ", \"min\": " << *std::min_element(result.seconds.begin(), result.seconds.end())
+        << ", \"stddev\": " << get_stddev(result.seconds)
+        << ", \"peak_memory\": " << result.peak_memory;
+    // Counters of the last run, only in builds with SALIB_MEMORY_ACCOUNTING
+    if (MemoryAccounting::is_enabled()) {
+        out << ", \"memory\": ";
+        MemoryAccounting::write_json(out);
+    }
+    auto it = baseline.find(ResultKey(result.system, result.order, result.algorithm));
+    bool regressed = false;
+    if (it != baseline.end() && it->second > 0) {
+        double ratio = median / it->second;
+        regressed = ratio > 1 + tolerance;
+        out << ", \"baseline_median\": " << it->second << ", \"ratio\": " << ratio;
+    }
+    out << "}";
+    return regressed;
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parse_options(argc, argv, options)) {
+        cerr << "Usage:\n"
+             << "  " << argv[0] << " [--orders lex,deglex,degrevlex] [--algorithms buchberger,f4,...]"
+             << " [--strategy normal] [--systems name,...] [--warmups 1] [--repetitions 5] [--timeout 60]"
+             << " [--threads 1] [--baseline file] [--tolerance 0.1] <suite file>\n";
+        return 1;
+    }
+    std::vector<SpeedTest::BasisAlgorithm> algorithms;
+    for (const auto& name : options.algorithms) {
+        SpeedTest::BasisAlgorithm algorithm;
+        if (!SpeedTest::parse_basis_algorithm(name, algorithm)) {
+            cerr << "Unknown basis algorithm " << name << "\n";
+            return 1;
+        }
+        algorithms.push_back(algorithm);
+    }
+    for (const auto& order : options.orders) {
+        if (order != "lex" && order != "deglex" && order != "degrevlex") {
+            cerr << "Unknown order " << order << "\n";
+            return 1;
+        }
+    }
+    std::map<ResultKey, double> baseline;
+    if (!options.baseline.empty() && !read_baseline(options.baseline, baseline)) {
+        cerr << "Can not read the baseline " << options.baseline << "\n";
+        return 1;
+    }
+
+    // Every system is parsed before the first run, so reading does not count in the memory peaks
+    std::ifstream in(options.suite);
+    if (!in) {
+        cerr << "Can not open " << options.suite << "\n";
+        return 1;
+    }
+    MapleReader<CoefType, InputOrder> reader(in);
+    std::vector<InputSystem> systems;
+    InputSystem system;
+    while (reader.read_system(system)) {
+        if (options.systems.empty() ||
+            std::find(options.systems.begin(), options.systems.end(), system.name) != options.systems.end())
+            systems.push_back(system);
+    }
+    if (reader.has_error()) {
+        cerr << "Can not read " << options.suite << ": " << reader.get_error() << "\n";
+        return 1;
+    }
+
+    cout << "{\"suite\": \"" << options.suite << "\", \"strategy\": \"" << to_string(options.strategy)
+         << "\", \"warmups\": " << options.warmups << ", \"repetitions\": " << options.repetitions
+         << ", \"timeout\": " << options.timeout << ", \"results\": [";
+    bool first = true;
+    size_t regressions = 0;
+    for (const auto& input : systems) {
+        for (const auto& order : options.orders) {
+            for (size_t idx = 0; idx < algorithms.size(); ++idx) {
+                cerr << input.name << " " << order << " " << options.algorithms[idx] << "\n";
+                Result result;
+                if (order == "lex")
+                    result = run_system<MonoLexOrder>(input, order, options.algorithms[idx], algorithms[idx], options);
+                else if (order == "deglex")
+                    result = run_system<CustomOrder<MonoGradientSemiOrder, MonoLexOrder>>(
+                        input, order, options.algorithms[idx], algorithms[idx], options);
+                else
+                    result = run_system<CustomOrder<MonoGradientSemiOrder, RevOrder<MonoLexOrder>>>(
+                        input, order, options.algorithms[idx], algorithms[idx], options);
+                cout << (first ? "\n" : ",\n");
+                first = false;
+                regressions += write_result(cout, result, baseline, options.tolerance);
+                cout.flush();
+            }
+        }
+    }
+    cout << "\n]}\n";
+    if (regressions > 0) {
+        cerr << regressions << " results are slower than the baseline by more than "
+             << options.tolerance * 100 << "%\n";
+        return 2;
+    }
+    return 0;
+}
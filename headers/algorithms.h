@@ -1,11 +1,23 @@
 #pragma once
 #include "polynomial_set.h"
+#include "critical_pairs.h"
+#include "computation_context.h"
+#include "buchberger_statistics.h"
+#include "memory_accounting.h"
+#include "checkpoint.h"
+#include "trace.h"
 #include <vector>
 #include <queue>
 #include <iostream>
 #include <utility>
+#include <algorithm>
 
 namespace SALIB {
+    enum class ReductionMode {
+        TOP,    // Only the leading term is reduced, the tail is left as is
+        FULL    // Every term is reduced
+    };
+
     template <typename CoefficientType, typename Order = DefaultOrder>
     class PolyAlg {
     public:
@@ -15,7 +27,9 @@ namespace SALIB {
         inline static PolynomialType reduce_by(
             PolynomialType divider,
             const std::vector<PolynomialType>& divisors,
-            std::vector<PolynomialType>* incomplete_quotients = 0
+            std::vector<PolynomialType>* incomplete_quotients = 0,
+            ReductionMode mode = ReductionMode::FULL,
+            ComputationContext* context = nullptr
         );
 
         template <typename PolyOrder, typename SetOrder>
@@ -24,13 +38,54 @@ namespace SALIB {
             const PolynomialSet<CoefficientType, SetOrder>& divisors
         );
 
-        inline static void make_groebner_basis(std::vector<PolynomialType>& ideal);
+        // Subtracts multiples of divisor while its leading monomial divides the leading monomial of divider,
+        // returns false if it did not divide it at all
+        inline static bool reduce_by_one(
+            PolynomialType& divider,
+            const PolynomialType& divisor,
+            PolynomialType* incomplete_quotient = nullptr,
+            BuchbergerStatistics* statistics = nullptr
+        );
+
+        // S-polynomials are fully reduced, see ComputationContext::set_lazy_tail_reduction for the alternative.
+        // If the context stops the computation, ideal holds the partial basis without a final tail reduction.
+        // With a degree limit in the context the basis is truncated, the context tells if it is complete anyway
+        inline static void make_groebner_basis(
+            std::vector<PolynomialType>& ideal,
+            PairSelectionStrategy strategy = PairSelectionStrategy::NORMAL,
+            ComputationContext* context = nullptr
+        );
+
+        // Continues from a checkpoint of make_groebner_basis (see ComputationContext::set_checkpoint) with the
+        // saved strategy and degree limit. The basis is the one an uninterrupted run with the same context
+        // options gives.
+        // Returns false if the file can not be loaded
+        inline static bool resume_groebner_basis(
+            const std::string& checkpoint_file,
+            std::vector<PolynomialType>& ideal,
+            ComputationContext* context = nullptr
+        );
+
+        // Fully reduces every tail by the basis, leading terms are kept
+        inline static void tail_reduce(std::vector<PolynomialType>& basis, BuchbergerStatistics* statistics = nullptr);
+
+        // A non-zero constant generates the unit ideal
+        inline static bool is_nonzero_constant(const PolynomialType& poly);
+
+        template <typename PolyOrder>
+        inline static bool is_homogeneous(const Polynomial<CoefficientType, PolyOrder>& poly);
+
+        // Leaves a generating set with pairwise non-divisible leading monomials, reduced monic tails.
+        // For a Groebner basis this is the reduced Groebner basis
+        inline static void interreduce(std::vector<PolynomialType>& ideal, BuchbergerStatistics* statistics = nullptr);
 
-        inline static PolySet auto_reduce(const PolySet& ideal);
+        inline static PolySet auto_reduce(const PolySet& ideal, BuchbergerStatistics* statistics = nullptr);
 
         template <typename SetOrder>
         inline static PolySet make_groebner_basis(
-            const PolynomialSet<CoefficientType, SetOrder>& ideal
+            const PolynomialSet<CoefficientType, SetOrder>& ideal,
+            PairSelectionStrategy strategy = PairSelectionStrategy::NORMAL,
+            ComputationContext* context = nullptr
         );
 
         template <typename PolyOrder, typename SetOrder>
@@ -46,29 +101,78 @@ namespace SALIB {
             Monomial::VariableIndexType free_variable
         );
 
+        // basis must be a Groebner basis, e.g. from make_groebner_basis, so repeated queries compute it once.
+        // The powers are reduced by it and the Rabinowitsch trick only processes the pairs of the new generator
+        inline static bool is_polynomial_in_radical(
+            const PolynomialType& poly,
+            const std::vector<PolynomialType>& basis,
+            Monomial::VariableIndexType free_variable
+        );
+
+        // The basis is computed in an elimination order with t before every variable of the ideals,
+        // so free_variable is not needed anymore and only kept for compatibility
         template <typename SetOrder>
         inline static PolySet intersect_ideals(
             const PolynomialSet<CoefficientType, SetOrder>& ideal1,
             const PolynomialSet<CoefficientType, SetOrder>& ideal2,
             Monomial::VariableIndexType free_variable
         );
+
+        // Reduced Groebner basis of the intersection
+        template <typename SetOrder>
+        inline static PolySet intersect_ideals(
+            const PolynomialSet<CoefficientType, SetOrder>& ideal1,
+            const PolynomialSet<CoefficientType, SetOrder>& ideal2
+        );
+
+        static const size_t INTERSECTION_BLOCK = 4;
+
+        // Reduced Groebner basis of the intersection. Up to BlockSize + 1 ideals share one basis computation
+        // with BlockSize new variables, longer lists take levels of evenly sized blocks. Inputs containing a
+        // nonzero constant are skipped, the intersection of no ideals is {1}
+        template <size_t BlockSize = INTERSECTION_BLOCK, typename SetOrder>
+        inline static PolySet intersect_all(const std::vector<PolynomialSet<CoefficientType, SetOrder>>& ideals);
+
     private:
+        // Variables t_0, ..., t_{BlockSize - 1} take the first indices, the ideals are shifted past them
+        template <size_t BlockSize>
+        using EliminationPolynomial = Polynomial<CoefficientType, CustomOrder<PrefixLexSemiOrder<BlockSize>, Order>>;
+
+        // I_0 ∩ ... ∩ I_m is the t-free part of t_0 I_0 + ... + t_{m - 1} I_{m - 1} + (1 - t_0 - ... - t_{m - 1}) I_m,
+        // m must not exceed BlockSize
+        template <size_t BlockSize>
+        inline static PolySet intersect_block(const std::vector<const PolySet*>& ideals);
+
+        template <size_t BlockSize>
+        inline static EliminationPolynomial<BlockSize> shift_variables(const PolynomialType& poly);
+        template <size_t BlockSize>
+        inline static PolynomialType unshift_variables(const EliminationPolynomial<BlockSize>& poly);
+
+        // The pair loop of make_groebner_basis and the final tail reduction of its lazy mode
+        inline static void complete_basis(
+            std::vector<PolynomialType>& ideal,
+            PairQueue<Order>& pairs,
+            ComputationContext* context
+        );
+
+        // Powers of a polynomial tried by normal forms before the Rabinowitsch trick
+        static const size_t RADICAL_POWERS = 4;
+
         inline static bool try_to_reduce(
                 PolynomialType& divider,
                 const std::vector<PolynomialType>& divisors,
-                std::vector<PolynomialType>* incomplete_quotients);
+                std::vector<PolynomialType>* incomplete_quotients,
+                BuchbergerStatistics* statistics);
 
-        inline static bool reduce_by_one(
-                PolynomialType& divider,
-                const PolynomialType& divisor,
-                PolynomialType* incomplete_quotient
-                );
-
-        inline static bool check_optimization_criterion(
-                const std::vector<PolynomialType>& ideal,
-                const Monomial& current_pair_lcm_lt,
-                int polys_processed
-                );
+        // reduce_by that counts its steps, statistics may be set without a context
+        inline static PolynomialType reduce_with_statistics(
+            PolynomialType divider,
+            const std::vector<PolynomialType>& divisors,
+            std::vector<PolynomialType>* incomplete_quotients,
+            ReductionMode mode,
+            ComputationContext* context,
+            BuchbergerStatistics* statistics
+        );
     };
 
     class PairMaker {
@@ -102,6 +206,12 @@ namespace SALIB {
     /*
 =================================IMPLEMENTATION=================================
 */
+    template <typename CoefficientType, typename Order>
+    const size_t PolyAlg<CoefficientType, Order>::RADICAL_POWERS;
+
+    template <typename CoefficientType, typename Order>
+    const size_t PolyAlg<CoefficientType, Order>::INTERSECTION_BLOCK;
+
     PairMaker::iterator::iterator(PairMaker::iterator::Value v) : value(std::move(v)) {}
 
     PairMaker::iterator &PairMaker::iterator::operator++() {
@@ -154,7 +264,9 @@ namespace SALIB {
     bool PolyAlg<CoefficientType, Order>::reduce_by_one(
             PolynomialType& divider,
             const PolynomialType& divisor,
-            PolynomialType* incomplete_quotient) {
+            PolynomialType* incomplete_quotient,
+            BuchbergerStatistics* statistics) {
+        statistics = BuchbergerStatistics::active(statistics);
         Monomial divider_lt = divider.get_largest_monomial();
         Monomial divisor_lt = divisor.get_largest_monomial();
         if (divider.is_zero() || !divider_lt.is_dividable_by(divisor_lt))
@@ -165,6 +277,8 @@ namespace SALIB {
             if (incomplete_quotient)
                 (*incomplete_quotient) += subs;
             divider -= subs * divisor;
+            if (statistics)
+                ++statistics->reduction_steps;
 
             divider_lt = divider.get_largest_monomial();
             divisor_lt = divisor.get_largest_monomial();
@@ -176,10 +290,12 @@ namespace SALIB {
     bool PolyAlg<CoefficientType, Order>::try_to_reduce(
             PolynomialType& divider,
             const std::vector<PolynomialType>& divisors,
-            std::vector<PolynomialType>* incomplete_quotients) {
+            std::vector<PolynomialType>* incomplete_quotients,
+            BuchbergerStatistics* statistics) {
         bool is_reduced = false;
         for (size_t i = 0; i < divisors.size() && !divider.is_zero(); ++i) {
-            is_reduced |= reduce_by_one(divider, divisors[i], (incomplete_quotients) ? &(*incomplete_quotients)[i] : nullptr);
+            is_reduced |= reduce_by_one(divider, divisors[i], (incomplete_quotients) ? &(*incomplete_quotients)[i] : nullptr,
+                                        statistics);
         }
         return is_reduced;
     }
@@ -189,14 +305,42 @@ namespace SALIB {
     PolyAlg<CoefficientType, Order>::reduce_by(
         PolynomialType divider,
         const std::vector<PolynomialType>& divisors,
-        std::vector<PolynomialType>* incomplete_quotients
+        std::vector<PolynomialType>* incomplete_quotients,
+        ReductionMode mode,
+        ComputationContext* context
+    ) {
+        return reduce_with_statistics(std::move(divider), divisors, incomplete_quotients, mode, context,
+                                      context ? context->get_statistics() : nullptr);
+    }
+
+    template <typename CoefficientType, typename Order>
+    typename PolyAlg<CoefficientType, Order>::PolynomialType
+    PolyAlg<CoefficientType, Order>::reduce_with_statistics(
+        PolynomialType divider,
+        const std::vector<PolynomialType>& divisors,
+        std::vector<PolynomialType>* incomplete_quotients,
+        ReductionMode mode,
+        ComputationContext* context,
+        BuchbergerStatistics* statistics
     ) {
+        TraceSpan span("reduce_by");
+        statistics = BuchbergerStatistics::active(statistics);
         if (incomplete_quotients) {
             incomplete_quotients->assign(divisors.size(), PolynomialType());
         }
+        // An interrupted reduction returns a polynomial congruent to the divider, not its normal form
+        auto stopped = [context]() {
+            return context && context->should_stop();
+        };
+        if (mode == ReductionMode::TOP) {
+            while (!stopped() && try_to_reduce(divider, divisors, incomplete_quotients, statistics)) {}
+            return divider;
+        }
         PolynomialType rest;
         while (!divider.is_zero()) {
-            while (try_to_reduce(divider, divisors, incomplete_quotients)) {}
+            if (stopped())
+                return rest + divider;
+            while (try_to_reduce(divider, divisors, incomplete_quotients, statistics) && !stopped()) {}
 
             rest += divider.get_largest_monomial_as_poly();
             divider -= divider.get_largest_monomial_as_poly();
@@ -222,68 +366,223 @@ namespace SALIB {
     }
 
     template <typename CoefficientType, typename Order>
-    typename PolyAlg<CoefficientType, Order>::PolySet PolyAlg<CoefficientType, Order>::auto_reduce(
-            const PolynomialSet<CoefficientType, Order>& ideal) {
-        PolySet res(ideal);
-        PolySet temp;
-        bool reducing = true;
-        while (reducing) {
-            reducing = false;
-            temp = res;
-            for (const auto& poly : temp) {
-                
-    //            std::cerr << "Poly from ideal " << poly << "\n";
-                res.remove(poly);
-                PolynomialType reduced = reduce_by(poly, res);
-                if (reduced.is_zero() || poly.get_largest_monomial() != reduced.get_largest_monomial()) {
-                    reducing = true;
+    void PolyAlg<CoefficientType, Order>::interreduce(
+            std::vector<PolynomialType>& ideal,
+            BuchbergerStatistics* statistics) {
+        TraceSpan span("interreduce");
+        statistics = BuchbergerStatistics::active(statistics);
+        MemoryPhaseScope phase(MemoryPhase::INTERREDUCTION);
+        auto by_leading_monomial = [](const PolynomialType& a, const PolynomialType& b) {
+            return Order::cmp(a.get_largest_monomial(), b.get_largest_monomial()) > 0;
+        };
+        // Worklist with the smallest leading monomial at the back
+        std::vector<PolynomialType> todo;
+        todo.reserve(ideal.size());
+        for (auto& poly : ideal) {
+            if (!poly.is_zero())
+                todo.push_back(std::move(poly));
+        }
+        std::sort(todo.begin(), todo.end(), by_leading_monomial);
+
+        std::vector<PolynomialType> reduced;
+        BuchbergerStatistics::Timer timer(statistics, &BuchbergerStatistics::interreduction_seconds);
+        while (!todo.empty()) {
+            PolynomialType poly = reduce_with_statistics(std::move(todo.back()), reduced, nullptr, ReductionMode::TOP,
+                                                         nullptr, statistics);
+            todo.pop_back();
+            if (poly.is_zero())
+                continue;
+            // For a non Groebner basis input a new leading monomial may divide earlier ones
+            const Monomial& lt = poly.get_largest_monomial();
+            bool requeued = false;
+            for (size_t idx = 0; idx < reduced.size();) {
+                if (reduced[idx].get_largest_monomial().is_dividable_by(lt)) {
+                    todo.push_back(std::move(reduced[idx]));
+                    reduced[idx] = std::move(reduced.back());
+                    reduced.pop_back();
+                    requeued = true;
+                } else {
+                    ++idx;
                 }
-                res.add(reduced);
             }
+            if (requeued)
+                std::sort(todo.begin(), todo.end(), by_leading_monomial);
+            reduced.push_back(std::move(poly));
         }
-        return res;
+
+        timer.stop();
+        tail_reduce(reduced, statistics);
+        for (auto& poly : reduced)
+            poly *= PolynomialType(CoefficientType(1) / poly[poly.get_largest_monomial()]);
+        ideal = std::move(reduced);
     }
 
     template <typename CoefficientType, typename Order>
-    bool PolyAlg<CoefficientType, Order>::check_optimization_criterion(
-            const std::vector<PolynomialType>& ideal,
-            const Monomial& current_pair_lcm_lt,
-            int polys_processed
-    ) {
-        for (size_t l = 0; l < polys_processed; ++l) {
-            if (current_pair_lcm_lt.is_dividable_by(ideal[l].get_largest_monomial()))
-                return true;
-        }
-        return false;
+    typename PolyAlg<CoefficientType, Order>::PolySet PolyAlg<CoefficientType, Order>::auto_reduce(
+            const PolynomialSet<CoefficientType, Order>& ideal,
+            BuchbergerStatistics* statistics) {
+        TraceSpan span("auto_reduce");
+        MemoryPhaseScope phase(MemoryPhase::INPUT_CONVERSION);
+        std::vector<PolynomialType> polys(ideal.begin(), ideal.end());
+        interreduce(polys, statistics);
+        PolySet res;
+        for (const auto& poly : polys)
+            res.add(poly);
+        return res;
     }
 
     template <typename CoefficientType, typename Order>
     void
     PolyAlg<CoefficientType, Order>::make_groebner_basis(
-        std::vector<PolynomialType>& ideal
+        std::vector<PolynomialType>& ideal,
+        PairSelectionStrategy strategy,
+        ComputationContext* context
     ) {
-        std::queue<std::pair<size_t, size_t>> pairs;
-        for (const auto& pr : PairMaker(ideal.size()))
-            pairs.push(pr);
+        TraceSpan span("make_groebner_basis");
+        BuchbergerStatistics* statistics = context ? context->get_statistics() : nullptr;
+        MemoryPhaseScope phase(MemoryPhase::PAIR_PROCESSING);
+        PairQueue<Order> pairs(strategy);
+        if (context)
+            pairs.set_max_degree(context->get_max_degree());
+        for (size_t idx = 0; idx < ideal.size(); ++idx) {
+            if (is_nonzero_constant(ideal[idx])) {
+                // The ideal is {1}, no pair has to be processed
+                ideal.assign(1, ideal[idx]);
+                pairs = PairQueue<Order>(strategy);
+                break;
+            }
+            pairs.add_element(ideal, PairQueue<Order>::get_total_degree(ideal[idx]), statistics);
+        }
+        complete_basis(ideal, pairs, context);
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool PolyAlg<CoefficientType, Order>::resume_groebner_basis(
+            const std::string& checkpoint_file,
+            std::vector<PolynomialType>& ideal,
+            ComputationContext* context) {
+        TraceSpan span("resume_groebner_basis");
+        PairQueue<Order> pairs;
+        if (!GroebnerCheckpoint<CoefficientType, Order>::load(checkpoint_file, ideal, pairs))
+            return false;
+        complete_basis(ideal, pairs, context);
+        return true;
+    }
+
+    template <typename CoefficientType, typename Order>
+    void PolyAlg<CoefficientType, Order>::complete_basis(
+            std::vector<PolynomialType>& ideal,
+            PairQueue<Order>& pairs,
+            ComputationContext* context) {
+        BuchbergerStatistics* statistics = context ? context->get_statistics() : nullptr;
+        MemoryPhaseScope phase(MemoryPhase::PAIR_PROCESSING);
+        // Once a constant appears the basis is {1}, no other pair has to be processed
+        auto found_unit = [&ideal, context]() {
+            ideal.assign(1, PolynomialType(CoefficientType(1)));
+            if (context) {
+                context->on_element_added(0);
+                context->finish();
+            }
+        };
+        auto reduce = [&ideal, context](PolynomialType poly, ReductionMode mode) {
+            MemoryPhaseScope reduction_phase(MemoryPhase::REDUCTION);
+            return reduce_by(std::move(poly), ideal, nullptr, mode, context);
+        };
+        // Only taken between pairs, when the basis and the queue agree
+        auto save_checkpoint = [&ideal, &pairs, context]() {
+            context->on_checkpoint_saved(
+                GroebnerCheckpoint<CoefficientType, Order>::save(context->get_checkpoint_file(), ideal, pairs));
+        };
+        if (ideal.size() == 1 && is_nonzero_constant(ideal.front()))
+            return found_unit();
+        if (statistics)
+            statistics->on_basis_size(ideal.size());
+        const bool lazy = context && context->is_lazy_tail_reduction();
 
         while (!pairs.empty()) {
-            size_t i = pairs.front().first;
-            size_t j = pairs.front().second;
-            pairs.pop();
-            Monomial i_lt = ideal[i].get_largest_monomial();
-            Monomial j_lt = ideal[j].get_largest_monomial();
-            Monomial lcm_i_j = Monomial::lcm(i_lt, j_lt);
-
-            if (lcm_i_j != i_lt * j_lt && !check_optimization_criterion(ideal, lcm_i_j, i)) {
-                PolynomialType s = PolynomialType::s_polynomial(ideal[i], ideal[j]);
-                s = reduce_by(s, ideal);
+            CriticalPair pair = pairs.pop();
+            if (!pairs.is_redundant(pair, ideal)) {
+                BuchbergerStatistics::Timer s_timer(statistics, &BuchbergerStatistics::s_polynomial_seconds);
+                PolynomialType s = PolynomialType::s_polynomial(ideal[pair.first], ideal[pair.second]);
+                s_timer.stop();
+                if (statistics) {
+                    ++statistics->s_polynomials;
+                    statistics->on_polynomial(s);
+                }
+                BuchbergerStatistics::Timer top_timer(statistics, &BuchbergerStatistics::top_reduction_seconds);
+                s = reduce(std::move(s), lazy ? ReductionMode::TOP : ReductionMode::FULL);
+                top_timer.stop();
+                if (context && context->is_stopped()) {
+                    // The interrupted pair is processed again after a resume
+                    if (!context->get_checkpoint_file().empty()) {
+                        pairs.requeue(std::move(pair));
+                        save_checkpoint();
+                    }
+                    return;
+                }
+                if (is_nonzero_constant(s))
+                    return found_unit();
                 if (!s.is_zero()) {
                     ideal.push_back(s);
-                    for (size_t t = 0; t < ideal.size() - 1; ++t) {
-                        pairs.push(std::make_pair(t, ideal.size() - 1));
+                    pairs.add_element(ideal, std::max(pair.sugar, PairQueue<Order>::get_total_degree(s)), statistics);
+                    if (statistics) {
+                        statistics->on_basis_size(ideal.size());
+                        statistics->on_polynomial(s);
                     }
+                    if (context)
+                        context->on_element_added(ideal.size() - 1);
+                } else if (statistics) {
+                    ++statistics->zero_reductions;
                 }
+            } else if (statistics) {
+                ++statistics->chain_criterion;
+            }
+            if (context && context->on_pair_processed(pairs.size(), ideal.size(), pair.lcm.get_degree())) {
+                if (!context->get_checkpoint_file().empty())
+                    save_checkpoint();
+                return;
             }
+            if (context && context->is_checkpoint_due())
+                save_checkpoint();
+        }
+        if (context)
+            context->set_truncated(!pairs.resolve_discarded(ideal));
+        if (lazy) {
+            MemoryPhaseScope tail_phase(MemoryPhase::REDUCTION);
+            tail_reduce(ideal, statistics);
+        }
+        if (context)
+            context->finish();
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool PolyAlg<CoefficientType, Order>::is_nonzero_constant(const PolynomialType& poly) {
+        return !poly.is_zero() && poly.get_largest_monomial().is_zero();
+    }
+
+    template <typename CoefficientType, typename Order>
+    template <typename PolyOrder>
+    bool PolyAlg<CoefficientType, Order>::is_homogeneous(const Polynomial<CoefficientType, PolyOrder>& poly) {
+        for (const auto& term : poly) {
+            if (term.first.get_degree() != poly.begin()->first.get_degree())
+                return false;
+        }
+        return true;
+    }
+
+    template <typename CoefficientType, typename Order>
+    void PolyAlg<CoefficientType, Order>::tail_reduce(
+            std::vector<PolynomialType>& basis,
+            BuchbergerStatistics* statistics) {
+        TraceSpan span("tail_reduce");
+        statistics = BuchbergerStatistics::active(statistics);
+        BuchbergerStatistics::Timer timer(statistics, &BuchbergerStatistics::tail_reduction_seconds);
+        // No tail monomial is divisible by its own leading monomial, so the basis is reduced in place
+        for (auto& poly : basis) {
+            if (poly.is_zero())
+                continue;
+            PolynomialType lead = poly.get_largest_monomial_as_poly();
+            poly = lead + reduce_with_statistics(poly - lead, basis, nullptr, ReductionMode::FULL, nullptr, statistics);
         }
     }
 
@@ -291,14 +590,17 @@ namespace SALIB {
     template <typename SetOrder>
     typename PolyAlg<CoefficientType, Order>::PolySet
     PolyAlg<CoefficientType, Order>::make_groebner_basis(
-        const PolynomialSet<CoefficientType, SetOrder>& ideal
+        const PolynomialSet<CoefficientType, SetOrder>& ideal,
+        PairSelectionStrategy strategy,
+        ComputationContext* context
     ) {
+        MemoryPhaseScope phase(MemoryPhase::INPUT_CONVERSION);
         std::vector<PolynomialType> new_ideal;
         new_ideal.reserve(ideal.size());
         for (const auto& p : ideal) {
             new_ideal.push_back(PolynomialType(p));
         }
-        make_groebner_basis(new_ideal);
+        make_groebner_basis(new_ideal, strategy, context);
         PolySet basis;
         for (const auto& p : new_ideal) {
             basis.add(p);
@@ -314,7 +616,14 @@ namespace SALIB {
         const PolynomialSet<CoefficientType, SetOrder>& ideal
         )
     {
-        PolySet basis = make_groebner_basis(ideal);
+        // For a homogeneous ideal the pairs above the degree of poly can not take part in its reduction
+        bool homogeneous = true;
+        for (const auto& gen : ideal)
+            homogeneous = homogeneous && is_homogeneous(gen);
+        ComputationContext context;
+        if (homogeneous)
+            context.set_max_degree(std::max<Monomial::VariableDegreeType>(1, PairQueue<Order>::get_total_degree(poly)));
+        PolySet basis = make_groebner_basis(ideal, PairSelectionStrategy::NORMAL, &context);
         PolynomialType reduced = reduce_by(poly, basis);
         return reduced.is_zero();
     }
@@ -328,14 +637,39 @@ namespace SALIB {
         Monomial::VariableIndexType free_variable
         )
     {
+        std::vector<PolynomialType> basis;
+        basis.reserve(ideal.size());
+        for (const auto& p : ideal)
+            basis.push_back(PolynomialType(p));
+        make_groebner_basis(basis);
+        return is_polynomial_in_radical(PolynomialType(poly), basis, free_variable);
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool PolyAlg<CoefficientType, Order>::is_polynomial_in_radical(
+            const PolynomialType& poly,
+            const std::vector<PolynomialType>& basis,
+            Monomial::VariableIndexType free_variable) {
+        // Cheap test first: some small power of poly may already reduce to zero
+        PolynomialType power = reduce_by(poly, basis);
+        for (size_t k = 1; k <= RADICAL_POWERS; ++k) {
+            if (power.is_zero())
+                return true;
+            if (k < RADICAL_POWERS)
+                power = reduce_by(power * poly, basis);
+        }
+
+        // Rabinowitsch trick on top of the basis: its own pairs are done already, the computation
+        // stops as soon as 1 appears
         PolynomialType t = PolynomialType(CoefficientType(1), Monomial(free_variable, 1));
-        PolynomialType one = PolynomialType(CoefficientType(1));
-        PolySet ideal_copy(ideal);
-        ideal_copy.add(one - t * poly);
-        PolySet basis = make_groebner_basis(ideal_copy);
-        PolynomialType reduced = reduce_by(one, basis);
-        return reduced.is_zero();
-        
+        std::vector<PolynomialType> extended(basis);
+        PairQueue<Order> pairs;
+        for (size_t idx = 0; idx < extended.size(); ++idx)
+            pairs.add_completed_element(extended);
+        extended.push_back(PolynomialType(CoefficientType(1)) - t * poly);
+        pairs.add_element(extended);
+        complete_basis(extended, pairs, nullptr);
+        return extended.size() == 1 && is_nonzero_constant(extended.front());
     }
 
     template <typename CoefficientType, typename Order>
@@ -344,14 +678,123 @@ namespace SALIB {
     PolyAlg<CoefficientType, Order>::intersect_ideals(
         const PolynomialSet<CoefficientType, SetOrder>& ideal1,
         const PolynomialSet<CoefficientType, SetOrder>& ideal2,
-        Monomial::VariableIndexType free_variable
+        Monomial::VariableIndexType
         )
     {
-        PolynomialType t = PolynomialType(CoefficientType(1), Monomial(free_variable, 1));
-        PolynomialType one = PolynomialType(CoefficientType(1));
-        PolySet new_ideal = ideal1 * t + ideal2 * (one - t);
-        PolySet basis = make_groebner_basis(new_ideal);
-        basis.remove_depending_polynomials(free_variable);
-        return basis;
+        return intersect_ideals(ideal1, ideal2);
+    }
+
+    template <typename CoefficientType, typename Order>
+    template <typename SetOrder>
+    typename PolyAlg<CoefficientType, Order>::PolySet
+    PolyAlg<CoefficientType, Order>::intersect_ideals(
+            const PolynomialSet<CoefficientType, SetOrder>& ideal1,
+            const PolynomialSet<CoefficientType, SetOrder>& ideal2) {
+        PolySet first(ideal1), second(ideal2);
+        return intersect_block<1>({&first, &second});
+    }
+
+    template <typename CoefficientType, typename Order>
+    template <size_t BlockSize, typename SetOrder>
+    typename PolyAlg<CoefficientType, Order>::PolySet
+    PolyAlg<CoefficientType, Order>::intersect_all(const std::vector<PolynomialSet<CoefficientType, SetOrder>>& ideals) {
+        static_assert(BlockSize > 0, "a block needs at least one new variable");
+        // The whole ring does not change the intersection
+        std::vector<PolySet> level;
+        for (const auto& ideal : ideals) {
+            bool is_unit = false;
+            for (const auto& poly : ideal)
+                is_unit = is_unit || is_nonzero_constant(PolynomialType(poly));
+            if (!is_unit)
+                level.push_back(PolySet(ideal));
+        }
+        if (level.empty()) {
+            PolySet unit;
+            unit.add(PolynomialType(CoefficientType(1)));
+            return unit;
+        }
+        if (level.size() == 1)
+            return auto_reduce(make_groebner_basis(level.front()));
+        while (level.size() > 1) {
+            // Evenly sized blocks, so that every block of a level has at least two ideals and each result
+            // is a reduced basis
+            size_t blocks_count = (level.size() + BlockSize) / (BlockSize + 1);
+            std::vector<PolySet> next;
+            size_t begin = 0;
+            for (size_t block_idx = 0; block_idx < blocks_count; ++block_idx) {
+                size_t end = begin + (level.size() - begin) / (blocks_count - block_idx);
+                std::vector<const PolySet*> block;
+                for (size_t idx = begin; idx < end; ++idx)
+                    block.push_back(&level[idx]);
+                next.push_back(intersect_block<BlockSize>(block));
+                begin = end;
+            }
+            level = std::move(next);
+        }
+        return level.front();
+    }
+
+    template <typename CoefficientType, typename Order>
+    template <size_t BlockSize>
+    typename PolyAlg<CoefficientType, Order>::template EliminationPolynomial<BlockSize>
+    PolyAlg<CoefficientType, Order>::shift_variables(const PolynomialType& poly) {
+        EliminationPolynomial<BlockSize> res;
+        for (const auto& term : poly) {
+            Monomial mono;
+            for (size_t var = 0; var < static_cast<size_t>(term.first.end() - term.first.begin()); ++var) {
+                if (term.first[var] != 0)
+                    mono.set_var_degree(var + BlockSize, term.first[var]);
+            }
+            res += EliminationPolynomial<BlockSize>(term.second, mono);
+        }
+        return res;
+    }
+
+    template <typename CoefficientType, typename Order>
+    template <size_t BlockSize>
+    typename PolyAlg<CoefficientType, Order>::PolynomialType
+    PolyAlg<CoefficientType, Order>::unshift_variables(const EliminationPolynomial<BlockSize>& poly) {
+        PolynomialType res;
+        for (const auto& term : poly) {
+            Monomial mono;
+            for (size_t var = BlockSize; var < static_cast<size_t>(term.first.end() - term.first.begin()); ++var) {
+                if (term.first[var] != 0)
+                    mono.set_var_degree(var - BlockSize, term.first[var]);
+            }
+            res += PolynomialType(term.second, mono);
+        }
+        return res;
+    }
+
+    template <typename CoefficientType, typename Order>
+    template <size_t BlockSize>
+    typename PolyAlg<CoefficientType, Order>::PolySet
+    PolyAlg<CoefficientType, Order>::intersect_block(const std::vector<const PolySet*>& ideals) {
+        using ElimPoly = EliminationPolynomial<BlockSize>;
+        std::vector<ElimPoly> polys;
+        ElimPoly last_factor = ElimPoly(CoefficientType(1));
+        for (size_t idx = 0; idx + 1 < ideals.size(); ++idx) {
+            ElimPoly t = ElimPoly(CoefficientType(1), Monomial(idx, 1));
+            last_factor -= t;
+            for (const auto& poly : *ideals[idx])
+                polys.push_back(t * shift_variables<BlockSize>(poly));
+        }
+        for (const auto& poly : *ideals.back())
+            polys.push_back(last_factor * shift_variables<BlockSize>(poly));
+
+        PolyAlg<CoefficientType, CustomOrder<PrefixLexSemiOrder<BlockSize>, Order>>::make_groebner_basis(polys);
+
+        // The t block is compared first, so an element is t-free exactly when its leading monomial is.
+        // Those elements form a Groebner basis of the intersection in Order, not a minimal one
+        std::vector<PolynomialType> basis;
+        for (const auto& poly : polys) {
+            if (PrefixLexSemiOrder<BlockSize>::cmp(poly.get_largest_monomial(), Monomial()) == 0)
+                basis.push_back(unshift_variables<BlockSize>(poly));
+        }
+        interreduce(basis);
+        PolySet res;
+        for (const auto& poly : basis)
+            res.add(poly);
+        return res;
     }
 }
@@ -0,0 +1,478 @@
+#pragma once
+#include "polynomial.h"
+#include "polynomial_set.h"
+#include "orders.h"
+#include "field.h"
+#include "mapped_file.h"
+#include <boost/rational.hpp>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+
+namespace SALIB {
+    // Binary polynomial set file, every block starts at a multiple of 8 bytes, native byte order:
+    //   BinaryHeader
+    //   uint64_t term_offsets[polynomials_count + 1]          terms of polynomial i are [offsets[i], offsets[i + 1])
+    //   exponents[terms_count][variables_count]              exponent_bytes each, leading term of a polynomial first
+    //   coefficients[terms_count]                            BinaryCoefficient<CoefficientType>::SIZE bytes each
+    // A file is opened as a view over the bytes, e.g. of a mapped file: nothing is parsed or allocated per term
+    struct BinaryHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t byte_order;
+        uint32_t order_tag;
+        uint32_t coefficient_tag;
+        uint64_t coefficient_parameter;     // The modulus of a prime field, the integer size of a rational
+        uint32_t coefficient_bytes;
+        uint32_t exponent_bytes;            // 1, 2, 4 or 8
+        uint64_t polynomials_count;
+        uint64_t variables_count;
+        uint64_t terms_count;
+        uint64_t exponents_offset;
+        uint64_t coefficients_offset;
+        uint64_t file_size;
+    };
+
+    const char BINARY_MAGIC[8] = {'S', 'A', 'L', 'I', 'B', 'P', 'S', '\0'};
+    const uint32_t BINARY_VERSION = 1;
+    const uint32_t BINARY_BYTE_ORDER = 0x01020304;
+
+    // Stable identifiers of the orders, a file is only opened with the order it was written with
+    template <typename Order>
+    struct BinaryOrderTag;
+
+    // Fixed size coefficient encodings, other coefficient types can not be written
+    template <typename CoefficientType>
+    struct BinaryCoefficient;
+
+    // True for the coefficient types with a BinaryCoefficient encoding
+    template <typename CoefficientType>
+    struct HasBinaryCoefficient : std::false_type {};
+
+    class BinaryMonomialView {
+    public:
+        inline BinaryMonomialView(const unsigned char* data, size_t variables_count, size_t exponent_bytes);
+
+        inline Monomial::VariableDegreeType operator[](Monomial::VariableIndexType var) const;
+        inline size_t variables_count() const;
+        inline Monomial to_monomial() const;
+
+    private:
+        const unsigned char* data;
+        size_t variables;
+        size_t width;
+    };
+
+    template <typename CoefficientType, typename Order>
+    class BinaryPolynomialView {
+    public:
+        using PolynomialType = Polynomial<CoefficientType, Order>;
+
+        inline BinaryPolynomialView(const BinaryHeader& header, const unsigned char* base, size_t first, size_t last);
+
+        // Term 0 is the leading term
+        inline size_t size() const;
+        inline BinaryMonomialView get_monomial(size_t term) const;
+        inline CoefficientType get_coefficient(size_t term) const;
+
+        inline PolynomialType to_polynomial() const;
+
+    private:
+        const BinaryHeader& header;
+        const unsigned char* base;
+        size_t first;
+        size_t last;
+    };
+
+    template <typename CoefficientType, typename Order>
+    class BinaryPolySetView {
+    public:
+        using PolynomialType = Polynomial<CoefficientType, Order>;
+        using PolySet = PolynomialSet<CoefficientType, Order>;
+        using PolynomialView = BinaryPolynomialView<CoefficientType, Order>;
+
+        inline BinaryPolySetView();
+
+        // Checks the header and the block bounds, the bytes must outlive the view
+        inline bool open(const void* data, size_t size);
+
+        inline size_t size() const;
+        inline size_t get_variables_count() const;
+        inline PolynomialView operator[](size_t index) const;
+
+        inline PolySet to_polyset() const;
+
+    private:
+        const unsigned char* base;
+        const BinaryHeader* header;
+        const uint64_t* offsets;
+    };
+
+    template <typename CoefficientType, typename Order>
+    inline void write_binary(std::ostream& out, const std::vector<Polynomial<CoefficientType, Order>>& polys);
+
+    template <typename CoefficientType, typename Order>
+    inline void write_binary(std::ostream& out, const PolynomialSet<CoefficientType, Order>& polys);
+
+/*
+=================================IMPLEMENTATION=================================
+*/
+
+    inline uint32_t mix_binary_tags(uint32_t a, uint32_t b) {
+        return a * 1000003u ^ b;
+    }
+
+    template <typename ... Orders>
+    struct BinaryOrderListTag {
+        static uint32_t value() {
+            return 0;
+        }
+    };
+
+    template <typename FirstOrder, typename ... Orders>
+    struct BinaryOrderListTag<FirstOrder, Orders ...> {
+        static uint32_t value() {
+            return mix_binary_tags(BinaryOrderTag<FirstOrder>::value(), BinaryOrderListTag<Orders ...>::value());
+        }
+    };
+
+    template <>
+    struct BinaryOrderTag<MonoLexOrder> {
+        static uint32_t value() {
+            return 1;
+        }
+    };
+
+    template <>
+    struct BinaryOrderTag<MonoGradientSemiOrder> {
+        static uint32_t value() {
+            return 2;
+        }
+    };
+
+    template <size_t Count>
+    struct BinaryOrderTag<PrefixLexSemiOrder<Count>> {
+        static uint32_t value() {
+            return mix_binary_tags(3, static_cast<uint32_t>(Count));
+        }
+    };
+
+    template <typename Order>
+    struct BinaryOrderTag<RevOrder<Order>> {
+        static uint32_t value() {
+            return mix_binary_tags(4, BinaryOrderTag<Order>::value());
+        }
+    };
+
+    template <typename Order>
+    struct BinaryOrderTag<HomogenizedOrder<Order>> {
+        static uint32_t value() {
+            return mix_binary_tags(5, BinaryOrderTag<Order>::value());
+        }
+    };
+
+    template <typename ... Orders>
+    struct BinaryOrderTag<CustomOrder<Orders ...>> {
+        static uint32_t value() {
+            return mix_binary_tags(6, BinaryOrderListTag<Orders ...>::value());
+        }
+    };
+
+    template <int N>
+    struct HasBinaryCoefficient<Field<N>> : std::true_type {};
+
+    template <typename IntType>
+    struct HasBinaryCoefficient<boost::rational<IntType>> : std::true_type {};
+
+    template <int N>
+    struct BinaryCoefficient<Field<N>> {
+        static const uint32_t TAG = 1;
+        static const uint32_t SIZE = sizeof(uint32_t);
+
+        static uint64_t parameter() {
+            return N;
+        }
+
+        static void store(const Field<N>& coef, unsigned char* out) {
+            uint32_t value = static_cast<uint32_t>(coef.n);
+            std::memcpy(out, &value, SIZE);
+        }
+
+        static Field<N> load(const unsigned char* in) {
+            uint32_t value;
+            std::memcpy(&value, in, SIZE);
+            return Field<N>(value);
+        }
+    };
+
+    template <typename IntType>
+    struct BinaryCoefficient<boost::rational<IntType>> {
+        static const uint32_t TAG = 2;
+        static const uint32_t SIZE = 2 * sizeof(IntType);
+
+        static uint64_t parameter() {
+            return sizeof(IntType);
+        }
+
+        static void store(const boost::rational<IntType>& coef, unsigned char* out) {
+            IntType numerator = coef.numerator(), denominator = coef.denominator();
+            std::memcpy(out, &numerator, sizeof(IntType));
+            std::memcpy(out + sizeof(IntType), &denominator, sizeof(IntType));
+        }
+
+        static boost::rational<IntType> load(const unsigned char* in) {
+            IntType numerator, denominator;
+            std::memcpy(&numerator, in, sizeof(IntType));
+            std::memcpy(&denominator, in + sizeof(IntType), sizeof(IntType));
+            return boost::rational<IntType>(numerator, denominator);
+        }
+    };
+
+    // Overflow checked arithmetic for the sizes of an untrusted header, false if the result does not fit
+    inline bool add_binary_sizes(uint64_t a, uint64_t b, uint64_t& res) {
+        res = a + b;
+        return res >= a;
+    }
+
+    inline bool multiply_binary_sizes(uint64_t a, uint64_t b, uint64_t& res) {
+        res = a * b;
+        return a == 0 || res / a == b;
+    }
+
+    BinaryMonomialView::BinaryMonomialView(const unsigned char* data, size_t variables_count, size_t exponent_bytes)
+            : data(data), variables(variables_count), width(exponent_bytes) {}
+
+    Monomial::VariableDegreeType BinaryMonomialView::operator[](Monomial::VariableIndexType var) const {
+        if (var >= variables)
+            return 0;
+        const unsigned char* at = data + var * width;
+        switch (width) {
+            case 1:
+                return *at;
+            case 2: {
+                uint16_t value;
+                std::memcpy(&value, at, sizeof(value));
+                return value;
+            }
+            case 4: {
+                uint32_t value;
+                std::memcpy(&value, at, sizeof(value));
+                return value;
+            }
+        }
+        uint64_t value;
+        std::memcpy(&value, at, sizeof(value));
+        return value;
+    }
+
+    size_t BinaryMonomialView::variables_count() const {
+        return variables;
+    }
+
+    Monomial BinaryMonomialView::to_monomial() const {
+        Monomial mono;
+        for (size_t var = 0; var < variables; ++var) {
+            Monomial::VariableDegreeType degree = (*this)[var];
+            if (degree != 0)
+                mono.set_var_degree(var, degree);
+        }
+        return mono;
+    }
+
+    template <typename CoefficientType, typename Order>
+    BinaryPolynomialView<CoefficientType, Order>::BinaryPolynomialView(
+            const BinaryHeader& header,
+            const unsigned char* base,
+            size_t first,
+            size_t last) : header(header), base(base), first(first), last(last) {}
+
+    template <typename CoefficientType, typename Order>
+    size_t BinaryPolynomialView<CoefficientType, Order>::size() const {
+        return last - first;
+    }
+
+    template <typename CoefficientType, typename Order>
+    BinaryMonomialView BinaryPolynomialView<CoefficientType, Order>::get_monomial(size_t term) const {
+        size_t term_bytes = header.variables_count * header.exponent_bytes;
+        return BinaryMonomialView(base + header.exponents_offset + (first + term) * term_bytes,
+                                  header.variables_count, header.exponent_bytes);
+    }
+
+    template <typename CoefficientType, typename Order>
+    CoefficientType BinaryPolynomialView<CoefficientType, Order>::get_coefficient(size_t term) const {
+        return BinaryCoefficient<CoefficientType>::load(
+            base + header.coefficients_offset + (first + term) * BinaryCoefficient<CoefficientType>::SIZE);
+    }
+
+    template <typename CoefficientType, typename Order>
+    typename BinaryPolynomialView<CoefficientType, Order>::PolynomialType
+    BinaryPolynomialView<CoefficientType, Order>::to_polynomial() const {
+        // Terms are stored from the leading one down, so from_terms only reverses them
+        std::vector<typename PolynomialType::Term> terms;
+        terms.reserve(size());
+        for (size_t term = 0; term < size(); ++term)
+            terms.emplace_back(get_monomial(term).to_monomial(), get_coefficient(term));
+        return PolynomialType::from_terms(std::move(terms));
+    }
+
+    template <typename CoefficientType, typename Order>
+    BinaryPolySetView<CoefficientType, Order>::BinaryPolySetView() : base(nullptr), header(nullptr), offsets(nullptr) {}
+
+    template <typename CoefficientType, typename Order>
+    bool BinaryPolySetView<CoefficientType, Order>::open(const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        if (size < sizeof(BinaryHeader))
+            return false;
+        const BinaryHeader* head = reinterpret_cast<const BinaryHeader*>(bytes);
+        if (std::memcmp(head->magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0 || head->version != BINARY_VERSION ||
+            head->byte_order != BINARY_BYTE_ORDER)
+            return false;
+        if (head->order_tag != BinaryOrderTag<Order>::value() ||
+            head->coefficient_tag != BinaryCoefficient<CoefficientType>::TAG ||
+            head->coefficient_parameter != BinaryCoefficient<CoefficientType>::parameter() ||
+            head->coefficient_bytes != BinaryCoefficient<CoefficientType>::SIZE)
+            return false;
+        if (head->file_size != size || (head->exponent_bytes != 1 && head->exponent_bytes != 2 &&
+                                        head->exponent_bytes != 4 && head->exponent_bytes != 8))
+            return false;
+        // Every block must lie before the next one, the sizes come from the file and may overflow
+        uint64_t offsets_count, offsets_end, term_bytes, exponents_end, coefficient_block, coefficients_end;
+        if (!add_binary_sizes(head->polynomials_count, 1, offsets_count) ||
+            !multiply_binary_sizes(offsets_count, sizeof(uint64_t), offsets_end) ||
+            !add_binary_sizes(offsets_end, sizeof(BinaryHeader), offsets_end) ||
+            offsets_end > head->exponents_offset ||
+            !multiply_binary_sizes(head->variables_count, head->exponent_bytes, term_bytes) ||
+            !multiply_binary_sizes(head->terms_count, term_bytes, exponents_end) ||
+            !add_binary_sizes(head->exponents_offset, exponents_end, exponents_end) ||
+            exponents_end > head->coefficients_offset ||
+            !multiply_binary_sizes(head->terms_count, head->coefficient_bytes, coefficient_block) ||
+            !add_binary_sizes(head->coefficients_offset, coefficient_block, coefficients_end) ||
+            coefficients_end > size)
+            return false;
+        // Polynomial i owns the terms [offsets[i], offsets[i + 1]), all of them inside the term blocks
+        const uint64_t* term_offsets = reinterpret_cast<const uint64_t*>(bytes + sizeof(BinaryHeader));
+        for (size_t idx = 0; idx < head->polynomials_count; ++idx) {
+            if (term_offsets[idx] > term_offsets[idx + 1])
+                return false;
+        }
+        if (term_offsets[head->polynomials_count] != head->terms_count)
+            return false;
+        base = bytes;
+        header = head;
+        offsets = term_offsets;
+        return true;
+    }
+
+    template <typename CoefficientType, typename Order>
+    size_t BinaryPolySetView<CoefficientType, Order>::size() const {
+        return header ? header->polynomials_count : 0;
+    }
+
+    template <typename CoefficientType, typename Order>
+    size_t BinaryPolySetView<CoefficientType, Order>::get_variables_count() const {
+        return header ? header->variables_count : 0;
+    }
+
+    template <typename CoefficientType, typename Order>
+    typename BinaryPolySetView<CoefficientType, Order>::PolynomialView
+    BinaryPolySetView<CoefficientType, Order>::operator[](size_t index) const {
+        return PolynomialView(*header, base, offsets[index], offsets[index + 1]);
+    }
+
+    template <typename CoefficientType, typename Order>
+    typename BinaryPolySetView<CoefficientType, Order>::PolySet
+    BinaryPolySetView<CoefficientType, Order>::to_polyset() const {
+        PolySet res;
+        for (size_t idx = 0; idx < size(); ++idx)
+            res.add((*this)[idx].to_polynomial());
+        return res;
+    }
+
+    inline uint64_t align_binary_offset(uint64_t offset) {
+        return (offset + 7) / 8 * 8;
+    }
+
+    // Narrowed by value, so the layout matches BinaryMonomialView in either byte order
+    inline void store_binary_exponent(unsigned char* at, size_t width, uint64_t value) {
+        switch (width) {
+            case 1:
+                *at = static_cast<uint8_t>(value);
+                return;
+            case 2: {
+                uint16_t narrow = static_cast<uint16_t>(value);
+                std::memcpy(at, &narrow, sizeof(narrow));
+                return;
+            }
+            case 4: {
+                uint32_t narrow = static_cast<uint32_t>(value);
+                std::memcpy(at, &narrow, sizeof(narrow));
+                return;
+            }
+        }
+        std::memcpy(at, &value, sizeof(value));
+    }
+
+    template <typename CoefficientType, typename Order>
+    void write_binary(std::ostream& out, const std::vector<Polynomial<CoefficientType, Order>>& polys) {
+        using Coefficient = BinaryCoefficient<CoefficientType>;
+        BinaryHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+        header.version = BINARY_VERSION;
+        header.byte_order = BINARY_BYTE_ORDER;
+        header.order_tag = BinaryOrderTag<Order>::value();
+        header.coefficient_tag = Coefficient::TAG;
+        header.coefficient_parameter = Coefficient::parameter();
+        header.coefficient_bytes = Coefficient::SIZE;
+        header.polynomials_count = polys.size();
+
+        std::vector<uint64_t> offsets(1, 0);
+        Monomial::VariableDegreeType max_exponent = 0;
+        for (const auto& poly : polys) {
+            for (const auto& term : poly) {
+                size_t used = 0;
+                for (auto it = term.first.begin(); it != term.first.end(); ++it) {
+                    if (*it != 0)
+                        used = static_cast<size_t>(it - term.first.begin()) + 1;
+                    max_exponent = std::max(max_exponent, *it);
+                }
+                header.variables_count = std::max<uint64_t>(header.variables_count, used);
+                ++header.terms_count;
+            }
+            offsets.push_back(header.terms_count);
+        }
+        header.exponent_bytes = max_exponent <= 0xFF ? 1 : max_exponent <= 0xFFFF ? 2 : max_exponent <= 0xFFFFFFFFULL ? 4 : 8;
+        header.exponents_offset = align_binary_offset(sizeof(BinaryHeader) + offsets.size() * sizeof(uint64_t));
+        header.coefficients_offset = align_binary_offset(
+            header.exponents_offset + header.terms_count * header.variables_count * header.exponent_bytes);
+        header.file_size = header.coefficients_offset + header.terms_count * Coefficient::SIZE;
+
+        std::vector<unsigned char> exponents(header.coefficients_offset - header.exponents_offset, 0);
+        std::vector<unsigned char> coefficients(header.terms_count * Coefficient::SIZE);
+        size_t term_index = 0;
+        for (const auto& poly : polys) {
+            for (auto it = poly.rbegin(); it != poly.rend(); ++it, ++term_index) {
+                unsigned char* at = exponents.data() + term_index * header.variables_count * header.exponent_bytes;
+                for (size_t var = 0; var < header.variables_count; ++var)
+                    store_binary_exponent(at + var * header.exponent_bytes, header.exponent_bytes, it->first[var]);
+                Coefficient::store(it->second, coefficients.data() + term_index * Coefficient::SIZE);
+            }
+        }
+
+        const char padding[8] = {};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(uint64_t));
+        out.write(padding, header.exponents_offset - sizeof(header) - offsets.size() * sizeof(uint64_t));
+        out.write(reinterpret_cast<const char*>(exponents.data()), exponents.size());
+        out.write(reinterpret_cast<const char*>(coefficients.data()), coefficients.size());
+    }
+
+    template <typename CoefficientType, typename Order>
+    void write_binary(std::ostream& out, const PolynomialSet<CoefficientType, Order>& polys) {
+        write_binary(out, std::vector<Polynomial<CoefficientType, Order>>(polys.begin(), polys.end()));
+    }
+}
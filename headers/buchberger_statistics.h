@@ -0,0 +1,125 @@
+#pragma once
+#include "memory_accounting.h"
+#include <chrono>
+#include <ostream>
+#include <cstddef>
+
+namespace SALIB {
+    // Counters of PolyAlg, filled only in builds with SALIB_STATISTICS defined. Otherwise active() is always
+    // nullptr, so the algorithms skip every update and the collector stays zero
+    struct BuchbergerStatistics {
+        size_t pairs_generated = 0;
+        size_t product_criterion = 0;   // Never enqueued, coprime leading monomials
+        size_t chain_criterion = 0;     // Popped and dropped by PairQueue::is_redundant
+        size_t s_polynomials = 0;
+        size_t zero_reductions = 0;
+        size_t reduction_steps = 0;     // Multiples of a divisor subtracted by reduce_by_one
+        size_t peak_basis_size = 0;
+        size_t max_polynomial_length = 0;   // Terms of the longest S-polynomial or new basis element
+        size_t signature_criteria = 0;      // Pairs dropped by SignatureAlg, see SignatureStatistics
+
+        double pair_generation_seconds = 0;
+        double s_polynomial_seconds = 0;
+        double top_reduction_seconds = 0;   // S-polynomial reductions, only of the leading terms when lazy
+        double tail_reduction_seconds = 0;  // tail_reduce, e.g. after the last pair with lazy tail reduction
+        double interreduction_seconds = 0;
+
+        inline static constexpr bool is_enabled();
+        inline static BuchbergerStatistics* active(BuchbergerStatistics* statistics);
+
+        inline void on_basis_size(size_t size);
+        template <typename PolynomialType>
+        inline void on_polynomial(const PolynomialType& poly);
+
+        // One JSON object, the times are in seconds. Builds with SALIB_MEMORY_ACCOUNTING add the process wide
+        // MemoryAccounting counters as "memory"
+        inline void write_json(std::ostream& out) const;
+
+        // Adds the time of its scope to a field of the statistics, does nothing for nullptr
+        class Timer {
+        public:
+            inline Timer(BuchbergerStatistics* statistics, double BuchbergerStatistics::* field);
+            inline ~Timer();
+            // Ends the scope early
+            inline void stop();
+
+            Timer(const Timer&) = delete;
+            Timer& operator=(const Timer&) = delete;
+
+        private:
+            BuchbergerStatistics* statistics;
+            double BuchbergerStatistics::* field;
+            std::chrono::steady_clock::time_point start;
+        };
+    };
+
+/*
+=================================IMPLEMENTATION=================================
+*/
+
+    constexpr bool BuchbergerStatistics::is_enabled() {
+#ifdef SALIB_STATISTICS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    BuchbergerStatistics* BuchbergerStatistics::active(BuchbergerStatistics* statistics) {
+        return is_enabled() ? statistics : nullptr;
+    }
+
+    void BuchbergerStatistics::on_basis_size(size_t size) {
+        if (size > peak_basis_size)
+            peak_basis_size = size;
+    }
+
+    template <typename PolynomialType>
+    void BuchbergerStatistics::on_polynomial(const PolynomialType& poly) {
+        size_t length = 0;
+        for (auto it = poly.begin(); it != poly.end(); ++it)
+            ++length;
+        if (length > max_polynomial_length)
+            max_polynomial_length = length;
+    }
+
+    void BuchbergerStatistics::write_json(std::ostream& out) const {
+        out << "{\"enabled\": " << (is_enabled() ? "true" : "false")
+            << ", \"pairs_generated\": " << pairs_generated
+            << ", \"product_criterion\": " << product_criterion
+            << ", \"chain_criterion\": " << chain_criterion
+            << ", \"s_polynomials\": " << s_polynomials
+            << ", \"zero_reductions\": " << zero_reductions
+            << ", \"reduction_steps\": " << reduction_steps
+            << ", \"peak_basis_size\": " << peak_basis_size
+            << ", \"max_polynomial_length\": " << max_polynomial_length
+            << ", \"signature_criteria\": " << signature_criteria
+            << ", \"seconds\": {\"pair_generation\": " << pair_generation_seconds
+            << ", \"s_polynomial\": " << s_polynomial_seconds
+            << ", \"top_reduction\": " << top_reduction_seconds
+            << ", \"tail_reduction\": " << tail_reduction_seconds
+            << ", \"interreduction\": " << interreduction_seconds << "}";
+        if (MemoryAccounting::is_enabled()) {
+            out << ", \"memory\": ";
+            MemoryAccounting::write_json(out);
+        }
+        out << "}";
+    }
+
+    BuchbergerStatistics::Timer::Timer(BuchbergerStatistics* statistics, double BuchbergerStatistics::* field)
+            : statistics(statistics), field(field) {
+        if (statistics)
+            start = std::chrono::steady_clock::now();
+    }
+
+    BuchbergerStatistics::Timer::~Timer() {
+        stop();
+    }
+
+    void BuchbergerStatistics::Timer::stop() {
+        if (!statistics)
+            return;
+        statistics->*field += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        statistics = nullptr;
+    }
+}
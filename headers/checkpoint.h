@@ -0,0 +1,137 @@
+#pragma once
+#include "polynomial.h"
+#include "critical_pairs.h"
+#include "binary_io.h"
+#include "mapped_file.h"
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+namespace SALIB {
+    // State of a Buchberger computation on disk: the basis in the binary polynomial format, padded to 8 bytes,
+    // then the pair queue. It is written to filename + ".tmp" and renamed, so a crash never leaves a broken file.
+    // Coefficient types without a BinaryCoefficient encoding compile, but every save and load fails
+    template <typename CoefficientType, typename Order = DefaultOrder>
+    class GroebnerCheckpoint {
+    public:
+        using PolynomialType = Polynomial<CoefficientType, Order>;
+
+        inline static constexpr bool is_supported();
+
+        inline static bool save(
+            const std::string& filename,
+            const std::vector<PolynomialType>& basis,
+            const PairQueue<Order>& pairs
+        );
+
+        // Fails on a missing or damaged file and on a file of other coefficient or order types
+        inline static bool load(
+            const std::string& filename,
+            std::vector<PolynomialType>& basis,
+            PairQueue<Order>& pairs
+        );
+
+    private:
+        using Supported = std::integral_constant<bool, HasBinaryCoefficient<CoefficientType>::value>;
+
+        inline static bool save(const std::string& filename, const std::vector<PolynomialType>& basis,
+                                const PairQueue<Order>& pairs, std::true_type);
+        inline static bool save(const std::string&, const std::vector<PolynomialType>&,
+                                const PairQueue<Order>&, std::false_type);
+        inline static bool load(const std::string& filename, std::vector<PolynomialType>& basis,
+                                PairQueue<Order>& pairs, std::true_type);
+        inline static bool load(const std::string&, std::vector<PolynomialType>&, PairQueue<Order>&, std::false_type);
+    };
+
+/*
+=================================IMPLEMENTATION=================================
+*/
+
+    template <typename CoefficientType, typename Order>
+    constexpr bool GroebnerCheckpoint<CoefficientType, Order>::is_supported() {
+        return Supported::value;
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool GroebnerCheckpoint<CoefficientType, Order>::save(
+            const std::string& filename,
+            const std::vector<PolynomialType>& basis,
+            const PairQueue<Order>& pairs) {
+        return save(filename, basis, pairs, Supported());
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool GroebnerCheckpoint<CoefficientType, Order>::load(
+            const std::string& filename,
+            std::vector<PolynomialType>& basis,
+            PairQueue<Order>& pairs) {
+        return load(filename, basis, pairs, Supported());
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool GroebnerCheckpoint<CoefficientType, Order>::save(
+            const std::string& filename,
+            const std::vector<PolynomialType>& basis,
+            const PairQueue<Order>& pairs,
+            std::true_type) {
+        std::string temporary = filename + ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            if (!out)
+                return false;
+            write_binary(out, basis);
+            const char padding[8] = {};
+            std::streamoff written = out.tellp();
+            out.write(padding, (8 - written % 8) % 8);
+            pairs.save(out);
+            if (!out.flush())
+                return false;
+        }
+        return std::rename(temporary.c_str(), filename.c_str()) == 0;
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool GroebnerCheckpoint<CoefficientType, Order>::save(
+            const std::string&,
+            const std::vector<PolynomialType>&,
+            const PairQueue<Order>&,
+            std::false_type) {
+        return false;
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool GroebnerCheckpoint<CoefficientType, Order>::load(
+            const std::string& filename,
+            std::vector<PolynomialType>& basis,
+            PairQueue<Order>& pairs,
+            std::true_type) {
+        MappedFile file;
+        if (!file.open(filename) || file.size() < sizeof(BinaryHeader))
+            return false;
+        BinaryHeader header;
+        std::memcpy(&header, file.data(), sizeof(header));
+        BinaryPolySetView<CoefficientType, Order> view;
+        if (header.file_size > file.size() || !view.open(file.data(), header.file_size))
+            return false;
+        basis.clear();
+        basis.reserve(view.size());
+        for (size_t idx = 0; idx < view.size(); ++idx)
+            basis.push_back(view[idx].to_polynomial());
+
+        std::ifstream in(filename, std::ios::binary);
+        in.seekg(static_cast<std::streamoff>((header.file_size + 7) / 8 * 8));
+        return in && pairs.load(in, basis);
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool GroebnerCheckpoint<CoefficientType, Order>::load(
+            const std::string&,
+            std::vector<PolynomialType>&,
+            PairQueue<Order>&,
+            std::false_type) {
+        return false;
+    }
+}
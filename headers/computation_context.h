@@ -0,0 +1,338 @@
+#pragma once
+#include "monomial.h"
+#include "stopwatch.h"
+#include "buchberger_statistics.h"
+#include <atomic>
+#include <memory>
+#include <functional>
+#include <fstream>
+#include <string>
+#include <limits>
+#include <unistd.h>
+
+namespace SALIB {
+    enum class ComputationStatus {
+        RUNNING,
+        COMPLETE,
+        CANCELLED,
+        TIME_LIMIT,
+        MEMORY_LIMIT,
+        PAIR_LIMIT
+    };
+
+    inline std::string to_string(ComputationStatus status);
+
+    // Shared flag, a copy may be handed to another thread to cancel the computation
+    class CancellationToken {
+    public:
+        inline CancellationToken();
+
+        inline void cancel();
+        inline bool is_cancelled() const;
+
+    private:
+        std::shared_ptr<std::atomic<bool>> cancelled;
+    };
+
+    struct ComputationProgress {
+        size_t pairs_processed;
+        size_t pairs_remaining;
+        size_t basis_size;
+        Monomial::VariableDegreeType degree;  // Degree of the lcm of the last processed pair
+    };
+
+    // Budgets are counted from the construction of the context
+    class ComputationContext {
+    public:
+        using ProgressCallback = std::function<void(const ComputationProgress&)>;
+        // Receives the index of a new element in the basis vector of the computation
+        using ElementCallback = std::function<void(size_t)>;
+
+        inline ComputationContext();
+
+        inline void set_time_limit(double seconds);
+        inline void set_memory_limit(size_t bytes);
+        inline void set_pair_limit(size_t pairs);
+        inline void set_cancellation_token(CancellationToken token);
+        inline void set_progress_callback(ProgressCallback callback);
+        // Elements are reported as soon as they are added, with lazy tail reduction before their tails are reduced
+        inline void set_element_callback(ElementCallback callback);
+        // PolyAlg::make_groebner_basis saves its state to filename every interval seconds and when it is stopped
+        inline void set_checkpoint(const std::string& filename, double interval_seconds);
+        inline const std::string& get_checkpoint_file() const;
+        // True at most once per interval and only with a checkpoint file
+        inline bool is_checkpoint_due();
+        // Called with the result of every checkpoint save. A save fails on an unwritable file and for coefficient
+        // types that can not be written, see GroebnerCheckpoint
+        inline void on_checkpoint_saved(bool saved);
+        inline size_t get_failed_checkpoints() const;
+        // Pairs whose lcm has a larger total degree are not processed, 0 means no limit
+        inline void set_max_degree(Monomial::VariableDegreeType degree);
+        // PolyAlg then reduces only the leading terms of S-polynomials and every tail once after the last pair.
+        // Off by default: the unreduced tails lengthen later S-polynomials, cyclic6 over GF(32003) is 3x slower
+        inline void set_lazy_tail_reduction(bool value);
+        // Collected by PolyAlg only with SALIB_STATISTICS, the statistics must outlive the computation
+        inline void set_statistics(BuchbergerStatistics* statistics);
+
+        // Cheap enough for inner loops: clock and memory are only polled every few calls
+        inline bool should_stop();
+
+        // Called by the pair loop after every pair, returns true if the computation must stop
+        inline bool on_pair_processed(size_t pairs_remaining, size_t basis_size,
+                                      Monomial::VariableDegreeType degree);
+
+        // Called by the pair loop for every element it appends to the basis
+        inline void on_element_added(size_t index);
+
+        // Marks a computation that was not interrupted as complete
+        inline void finish();
+
+        inline ComputationStatus get_status() const;
+        inline bool is_stopped() const;
+        inline size_t get_pairs_processed() const;
+        inline double get_duration() const;
+        inline Monomial::VariableDegreeType get_max_degree() const;
+        inline bool is_lazy_tail_reduction() const;
+        // nullptr if nothing is collected
+        inline BuchbergerStatistics* get_statistics() const;
+
+        // A complete computation with a degree limit is truncated if a discarded pair could matter
+        inline void set_truncated(bool value);
+        inline bool is_truncated() const;
+
+        // Resident set size of the process, 0 if it can not be determined
+        inline static size_t get_resident_memory();
+        // Largest resident set size since the start of the process or the last reset, 0 if unknown
+        inline static size_t get_peak_resident_memory();
+        // Restarts the peak from the current resident set size, false if the kernel does not allow it
+        inline static bool reset_peak_resident_memory();
+
+    private:
+        inline bool check_limits();
+
+        static const size_t POLL_INTERVAL = 256;
+
+        StopWatch watch;
+        double time_limit = 0;
+        size_t memory_limit = 0;
+        size_t pair_limit = 0;
+        Monomial::VariableDegreeType max_degree = 0;
+        bool truncated = false;
+        bool lazy_tail_reduction = false;
+        BuchbergerStatistics* statistics = nullptr;
+        std::string checkpoint_file;
+        double checkpoint_interval = 0;
+        double last_checkpoint = 0;
+        size_t failed_checkpoints = 0;
+        size_t pairs_processed = 0;
+        size_t calls_since_poll = 0;
+        CancellationToken token;
+        ProgressCallback progress_callback;
+        ElementCallback element_callback;
+        ComputationStatus status = ComputationStatus::RUNNING;
+    };
+
+/*
+=================================IMPLEMENTATION=================================
+*/
+
+    std::string to_string(ComputationStatus status) {
+        switch (status) {
+            case ComputationStatus::RUNNING:
+                return "running";
+            case ComputationStatus::COMPLETE:
+                return "complete";
+            case ComputationStatus::CANCELLED:
+                return "cancelled";
+            case ComputationStatus::TIME_LIMIT:
+                return "time_limit";
+            case ComputationStatus::MEMORY_LIMIT:
+                return "memory_limit";
+            case ComputationStatus::PAIR_LIMIT:
+                return "pair_limit";
+        }
+        return "unknown";
+    }
+
+    CancellationToken::CancellationToken() : cancelled(std::make_shared<std::atomic<bool>>(false)) {}
+
+    void CancellationToken::cancel() {
+        cancelled->store(true);
+    }
+
+    bool CancellationToken::is_cancelled() const {
+        return cancelled->load(std::memory_order_relaxed);
+    }
+
+    ComputationContext::ComputationContext() {}
+
+    void ComputationContext::set_time_limit(double seconds) {
+        time_limit = seconds;
+    }
+
+    void ComputationContext::set_memory_limit(size_t bytes) {
+        memory_limit = bytes;
+    }
+
+    void ComputationContext::set_pair_limit(size_t pairs) {
+        pair_limit = pairs;
+    }
+
+    void ComputationContext::set_cancellation_token(CancellationToken new_token) {
+        token = std::move(new_token);
+    }
+
+    void ComputationContext::set_progress_callback(ProgressCallback callback) {
+        progress_callback = std::move(callback);
+    }
+
+    void ComputationContext::set_element_callback(ElementCallback callback) {
+        element_callback = std::move(callback);
+    }
+
+    void ComputationContext::set_checkpoint(const std::string& filename, double interval_seconds) {
+        checkpoint_file = filename;
+        checkpoint_interval = interval_seconds;
+        last_checkpoint = watch.get_duration();
+    }
+
+    const std::string& ComputationContext::get_checkpoint_file() const {
+        return checkpoint_file;
+    }
+
+    bool ComputationContext::is_checkpoint_due() {
+        if (checkpoint_file.empty())
+            return false;
+        double now = watch.get_duration();
+        if (now - last_checkpoint < checkpoint_interval)
+            return false;
+        last_checkpoint = now;
+        return true;
+    }
+
+    void ComputationContext::on_checkpoint_saved(bool saved) {
+        if (!saved)
+            ++failed_checkpoints;
+    }
+
+    size_t ComputationContext::get_failed_checkpoints() const {
+        return failed_checkpoints;
+    }
+
+    void ComputationContext::set_max_degree(Monomial::VariableDegreeType degree) {
+        max_degree = degree;
+    }
+
+    void ComputationContext::set_lazy_tail_reduction(bool value) {
+        lazy_tail_reduction = value;
+    }
+
+    void ComputationContext::set_statistics(BuchbergerStatistics* new_statistics) {
+        statistics = new_statistics;
+    }
+
+    size_t ComputationContext::get_resident_memory() {
+        std::ifstream statm("/proc/self/statm");
+        size_t total_pages = 0, resident_pages = 0;
+        if (!(statm >> total_pages >> resident_pages))
+            return 0;
+        return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    }
+
+    size_t ComputationContext::get_peak_resident_memory() {
+        std::ifstream status("/proc/self/status");
+        std::string key;
+        while (status >> key) {
+            if (key == "VmHWM:") {
+                size_t kilobytes = 0;
+                return (status >> kilobytes) ? kilobytes * 1024 : 0;
+            }
+            status.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+        return 0;
+    }
+
+    bool ComputationContext::reset_peak_resident_memory() {
+        std::ofstream clear_refs("/proc/self/clear_refs");
+        return static_cast<bool>(clear_refs << "5" << std::flush);
+    }
+
+    bool ComputationContext::check_limits() {
+        calls_since_poll = 0;
+        if (time_limit > 0 && watch.get_duration() > time_limit)
+            status = ComputationStatus::TIME_LIMIT;
+        else if (memory_limit > 0 && get_resident_memory() > memory_limit)
+            status = ComputationStatus::MEMORY_LIMIT;
+        return is_stopped();
+    }
+
+    bool ComputationContext::should_stop() {
+        if (is_stopped())
+            return true;
+        if (token.is_cancelled()) {
+            status = ComputationStatus::CANCELLED;
+            return true;
+        }
+        if (++calls_since_poll < POLL_INTERVAL)
+            return false;
+        return check_limits();
+    }
+
+    bool ComputationContext::on_pair_processed(
+            size_t pairs_remaining,
+            size_t basis_size,
+            Monomial::VariableDegreeType degree) {
+        ++pairs_processed;
+        if (progress_callback)
+            progress_callback(ComputationProgress{pairs_processed, pairs_remaining, basis_size, degree});
+        if (pair_limit > 0 && pairs_processed >= pair_limit && pairs_remaining > 0 && !is_stopped())
+            status = ComputationStatus::PAIR_LIMIT;
+        return should_stop();
+    }
+
+    void ComputationContext::on_element_added(size_t index) {
+        if (element_callback)
+            element_callback(index);
+    }
+
+    void ComputationContext::finish() {
+        if (status == ComputationStatus::RUNNING)
+            status = ComputationStatus::COMPLETE;
+    }
+
+    ComputationStatus ComputationContext::get_status() const {
+        return status;
+    }
+
+    bool ComputationContext::is_stopped() const {
+        return status != ComputationStatus::RUNNING && status != ComputationStatus::COMPLETE;
+    }
+
+    size_t ComputationContext::get_pairs_processed() const {
+        return pairs_processed;
+    }
+
+    double ComputationContext::get_duration() const {
+        return watch.get_duration();
+    }
+
+    Monomial::VariableDegreeType ComputationContext::get_max_degree() const {
+        return max_degree;
+    }
+
+    bool ComputationContext::is_lazy_tail_reduction() const {
+        return lazy_tail_reduction;
+    }
+
+    BuchbergerStatistics* ComputationContext::get_statistics() const {
+        return BuchbergerStatistics::active(statistics);
+    }
+
+    void ComputationContext::set_truncated(bool value) {
+        truncated = value;
+    }
+
+    bool ComputationContext::is_truncated() const {
+        return truncated;
+    }
+}
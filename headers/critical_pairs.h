@@ -0,0 +1,388 @@
+#pragma once
+#include "monomial.h"
+#include "orders.h"
+#include "buchberger_statistics.h"
+#include "memory_accounting.h"
+#include <vector>
+#include <set>
+#include <string>
+#include <utility>
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <cstdint>
+
+namespace SALIB {
+    enum class PairSelectionStrategy {
+        FIFO,           // Insertion order
+        NORMAL,         // Smallest lcm under the monomial order
+        SUGAR,          // Smallest sugar degree, ties broken by normal strategy
+        DEGREE_SUGAR    // Smallest total degree of lcm, then sugar, then normal strategy
+    };
+
+    inline std::string to_string(PairSelectionStrategy strategy);
+    inline bool parse_pair_selection_strategy(const std::string& name, PairSelectionStrategy& strategy);
+
+    struct CriticalPair {
+        using SugarType = Monomial::VariableDegreeType;
+
+        size_t first;
+        size_t second;
+        Monomial lcm;
+        SugarType sugar;
+        size_t sequence_number;
+    };
+
+    template <typename Order>
+    class PairQueue {
+    public:
+        using SugarType = CriticalPair::SugarType;
+
+        inline explicit PairQueue(PairSelectionStrategy strategy = PairSelectionStrategy::NORMAL);
+
+        template <typename PolynomialType>
+        inline static SugarType get_total_degree(const PolynomialType& poly);
+
+        // Registers basis[elements_count()] and enqueues its pairs with all previous elements
+        template <typename PolynomialType>
+        inline void add_element(const std::vector<PolynomialType>& basis);
+
+        template <typename PolynomialType>
+        inline void add_element(const std::vector<PolynomialType>& basis, SugarType sugar,
+                                BuchbergerStatistics* statistics = nullptr);
+
+        // Registers basis[elements_count()] without pairs, for the elements of an already complete basis
+        template <typename PolynomialType>
+        inline void add_completed_element(const std::vector<PolynomialType>& basis);
+
+        inline const CriticalPair& top() const;
+        inline CriticalPair pop();
+        // Puts a popped pair back, it is popped again in its old turn
+        inline void requeue(CriticalPair pair);
+
+        inline bool empty() const;
+        inline size_t size() const;
+        inline size_t elements_count() const;
+
+        inline bool is_pending(size_t i, size_t j) const;
+
+        // Buchberger's chain criterion, must be called after the pair is popped
+        template <typename PolynomialType>
+        inline bool is_redundant(const CriticalPair& pair, const std::vector<PolynomialType>& basis) const;
+
+        inline SugarType get_sugar(size_t index) const;
+        inline PairSelectionStrategy get_strategy() const;
+
+        // Pairs whose lcm has a larger total degree are discarded instead of enqueued, 0 means no limit
+        inline void set_max_degree(SugarType degree);
+        inline size_t discarded_count() const;
+
+        // Once the queue is empty: pops the discarded pairs in queue order while the chain criterion
+        // removes them. Returns true if all of them are gone, then the truncated basis is complete
+        template <typename PolynomialType>
+        inline bool resolve_discarded(const std::vector<PolynomialType>& basis);
+
+        // Binary state of the queue, lcms are not stored but recomputed from the basis by load.
+        // The heap is kept as is, so a loaded queue pops the pairs in the same order
+        inline void save(std::ostream& out) const;
+        template <typename PolynomialType>
+        inline bool load(std::istream& in, const std::vector<PolynomialType>& basis);
+
+    private:
+        using PairVector = std::vector<CriticalPair, AccountedAllocator<CriticalPair, MemoryCategory::PAIR_QUEUE>>;
+        using IndexPair = std::pair<size_t, size_t>;
+        using PendingSet = std::set<IndexPair, std::less<IndexPair>,
+                                    AccountedAllocator<IndexPair, MemoryCategory::PAIR_QUEUE>>;
+
+        inline bool has_lower_priority(const CriticalPair& a, const CriticalPair& b) const;
+
+        inline static void save_pairs(std::ostream& out, const PairVector& pairs);
+        template <typename PolynomialType>
+        inline static bool load_pairs(std::istream& in, const std::vector<PolynomialType>& basis,
+                                      PairVector& pairs);
+
+        PairVector pairs;
+        PendingSet pending;
+        std::vector<SugarType, AccountedAllocator<SugarType, MemoryCategory::PAIR_QUEUE>> sugars;
+        PairSelectionStrategy strategy;
+        size_t pushed_count = 0;
+        SugarType max_degree = 0;
+        // Discarded pairs stay pending, the chain criterion must not rely on them
+        PairVector discarded;
+    };
+
+/*
+=================================IMPLEMENTATION=================================
+*/
+
+    std::string to_string(PairSelectionStrategy strategy) {
+        switch (strategy) {
+            case PairSelectionStrategy::FIFO:
+                return "fifo";
+            case PairSelectionStrategy::NORMAL:
+                return "normal";
+            case PairSelectionStrategy::SUGAR:
+                return "sugar";
+            case PairSelectionStrategy::DEGREE_SUGAR:
+                return "degree_sugar";
+        }
+        return "unknown";
+    }
+
+    bool parse_pair_selection_strategy(const std::string& name, PairSelectionStrategy& strategy) {
+        for (auto candidate : {PairSelectionStrategy::FIFO, PairSelectionStrategy::NORMAL,
+                               PairSelectionStrategy::SUGAR, PairSelectionStrategy::DEGREE_SUGAR}) {
+            if (to_string(candidate) == name) {
+                strategy = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <typename Order>
+    PairQueue<Order>::PairQueue(PairSelectionStrategy strategy) : strategy(strategy) {}
+
+    template <typename Order>
+    template <typename PolynomialType>
+    typename PairQueue<Order>::SugarType PairQueue<Order>::get_total_degree(const PolynomialType& poly) {
+        SugarType degree = 0;
+        for (const auto& it : poly)
+            degree = std::max(degree, it.first.get_degree());
+        return degree;
+    }
+
+    template <typename Order>
+    template <typename PolynomialType>
+    void PairQueue<Order>::add_element(const std::vector<PolynomialType>& basis) {
+        add_element(basis, get_total_degree(basis[sugars.size()]));
+    }
+
+    template <typename Order>
+    template <typename PolynomialType>
+    void PairQueue<Order>::add_element(
+            const std::vector<PolynomialType>& basis,
+            SugarType sugar,
+            BuchbergerStatistics* statistics) {
+        BuchbergerStatistics::Timer timer(statistics, &BuchbergerStatistics::pair_generation_seconds);
+        size_t j = sugars.size();
+        if (statistics)
+            statistics->pairs_generated += j;
+        sugars.push_back(sugar);
+        const Monomial& j_lt = basis[j].get_largest_monomial();
+        for (size_t i = 0; i < j; ++i) {
+            const Monomial& i_lt = basis[i].get_largest_monomial();
+            Monomial lcm_i_j = Monomial::lcm(i_lt, j_lt);
+            // Product criterion: such pairs reduce to zero and are never enqueued
+            if (lcm_i_j == i_lt * j_lt) {
+                if (statistics)
+                    ++statistics->product_criterion;
+                continue;
+            }
+            SugarType pair_sugar = std::max(
+                sugars[i] + lcm_i_j.get_degree() - i_lt.get_degree(),
+                sugars[j] + lcm_i_j.get_degree() - j_lt.get_degree()
+            );
+            pending.insert(std::make_pair(i, j));
+            if (max_degree != 0 && lcm_i_j.get_degree() > max_degree) {
+                discarded.push_back(CriticalPair{i, j, std::move(lcm_i_j), pair_sugar, pushed_count++});
+                continue;
+            }
+            pairs.push_back(CriticalPair{i, j, std::move(lcm_i_j), pair_sugar, pushed_count++});
+            std::push_heap(pairs.begin(), pairs.end(), [this](const CriticalPair& a, const CriticalPair& b) {
+                return has_lower_priority(a, b);
+            });
+        }
+    }
+
+    template <typename Order>
+    template <typename PolynomialType>
+    void PairQueue<Order>::add_completed_element(const std::vector<PolynomialType>& basis) {
+        sugars.push_back(get_total_degree(basis[sugars.size()]));
+    }
+
+    template <typename Order>
+    const CriticalPair& PairQueue<Order>::top() const {
+        return pairs.front();
+    }
+
+    template <typename Order>
+    CriticalPair PairQueue<Order>::pop() {
+        std::pop_heap(pairs.begin(), pairs.end(), [this](const CriticalPair& a, const CriticalPair& b) {
+            return has_lower_priority(a, b);
+        });
+        CriticalPair res = std::move(pairs.back());
+        pairs.pop_back();
+        pending.erase(std::make_pair(res.first, res.second));
+        return res;
+    }
+
+    template <typename Order>
+    void PairQueue<Order>::requeue(CriticalPair pair) {
+        pending.insert(std::make_pair(pair.first, pair.second));
+        pairs.push_back(std::move(pair));
+        std::push_heap(pairs.begin(), pairs.end(), [this](const CriticalPair& a, const CriticalPair& b) {
+            return has_lower_priority(a, b);
+        });
+    }
+
+    template <typename Order>
+    bool PairQueue<Order>::empty() const {
+        return pairs.empty();
+    }
+
+    template <typename Order>
+    size_t PairQueue<Order>::size() const {
+        return pairs.size();
+    }
+
+    template <typename Order>
+    size_t PairQueue<Order>::elements_count() const {
+        return sugars.size();
+    }
+
+    template <typename Order>
+    bool PairQueue<Order>::is_pending(size_t i, size_t j) const {
+        if (i > j)
+            std::swap(i, j);
+        return pending.find(std::make_pair(i, j)) != pending.end();
+    }
+
+    template <typename Order>
+    template <typename PolynomialType>
+    bool PairQueue<Order>::is_redundant(const CriticalPair& pair, const std::vector<PolynomialType>& basis) const {
+        for (size_t l = 0; l < sugars.size(); ++l) {
+            if (l == pair.first || l == pair.second)
+                continue;
+            if (pair.lcm.is_dividable_by(basis[l].get_largest_monomial()) &&
+                !is_pending(pair.first, l) && !is_pending(pair.second, l))
+                return true;
+        }
+        return false;
+    }
+
+    template <typename Order>
+    typename PairQueue<Order>::SugarType PairQueue<Order>::get_sugar(size_t index) const {
+        return sugars[index];
+    }
+
+    template <typename Order>
+    PairSelectionStrategy PairQueue<Order>::get_strategy() const {
+        return strategy;
+    }
+
+    template <typename Order>
+    void PairQueue<Order>::set_max_degree(SugarType degree) {
+        max_degree = degree;
+    }
+
+    template <typename Order>
+    size_t PairQueue<Order>::discarded_count() const {
+        return discarded.size();
+    }
+
+    template <typename Order>
+    template <typename PolynomialType>
+    bool PairQueue<Order>::resolve_discarded(const std::vector<PolynomialType>& basis) {
+        std::sort(discarded.begin(), discarded.end(), [this](const CriticalPair& a, const CriticalPair& b) {
+            return has_lower_priority(b, a);
+        });
+        size_t resolved = 0;
+        while (resolved < discarded.size()) {
+            const CriticalPair& pair = discarded[resolved];
+            pending.erase(std::make_pair(pair.first, pair.second));
+            if (!is_redundant(pair, basis)) {
+                pending.insert(std::make_pair(pair.first, pair.second));
+                break;
+            }
+            ++resolved;
+        }
+        discarded.erase(discarded.begin(), discarded.begin() + resolved);
+        return discarded.empty();
+    }
+
+    template <typename Order>
+    void PairQueue<Order>::save_pairs(std::ostream& out, const PairVector& pairs) {
+        std::vector<uint64_t> fields;
+        fields.reserve(1 + 4 * pairs.size());
+        fields.push_back(pairs.size());
+        for (const auto& pair : pairs) {
+            fields.push_back(pair.first);
+            fields.push_back(pair.second);
+            fields.push_back(pair.sugar);
+            fields.push_back(pair.sequence_number);
+        }
+        out.write(reinterpret_cast<const char*>(fields.data()), fields.size() * sizeof(uint64_t));
+    }
+
+    template <typename Order>
+    void PairQueue<Order>::save(std::ostream& out) const {
+        std::vector<uint64_t> fields = {static_cast<uint64_t>(strategy), pushed_count, max_degree, sugars.size()};
+        fields.insert(fields.end(), sugars.begin(), sugars.end());
+        out.write(reinterpret_cast<const char*>(fields.data()), fields.size() * sizeof(uint64_t));
+        save_pairs(out, pairs);
+        save_pairs(out, discarded);
+    }
+
+    template <typename Order>
+    template <typename PolynomialType>
+    bool PairQueue<Order>::load_pairs(
+            std::istream& in,
+            const std::vector<PolynomialType>& basis,
+            PairVector& pairs) {
+        uint64_t count = 0;
+        if (!in.read(reinterpret_cast<char*>(&count), sizeof(count)))
+            return false;
+        std::vector<uint64_t> fields(4 * count);
+        if (!in.read(reinterpret_cast<char*>(fields.data()), fields.size() * sizeof(uint64_t)))
+            return false;
+        pairs.clear();
+        pairs.reserve(count);
+        for (size_t idx = 0; idx < fields.size(); idx += 4) {
+            size_t i = fields[idx], j = fields[idx + 1];
+            if (i >= j || j >= basis.size())
+                return false;
+            Monomial lcm = Monomial::lcm(basis[i].get_largest_monomial(), basis[j].get_largest_monomial());
+            pairs.push_back(CriticalPair{i, j, std::move(lcm), fields[idx + 2], fields[idx + 3]});
+        }
+        return true;
+    }
+
+    template <typename Order>
+    template <typename PolynomialType>
+    bool PairQueue<Order>::load(std::istream& in, const std::vector<PolynomialType>& basis) {
+        uint64_t header[4];
+        if (!in.read(reinterpret_cast<char*>(header), sizeof(header)) || header[0] > 3 || header[3] != basis.size())
+            return false;
+        strategy = static_cast<PairSelectionStrategy>(header[0]);
+        pushed_count = header[1];
+        max_degree = header[2];
+        sugars.resize(header[3]);
+        if (!in.read(reinterpret_cast<char*>(sugars.data()), sugars.size() * sizeof(SugarType)))
+            return false;
+        if (!load_pairs(in, basis, pairs) || !load_pairs(in, basis, discarded))
+            return false;
+        // Exactly the queued and the discarded pairs are pending
+        pending.clear();
+        for (const auto& pair : pairs)
+            pending.insert(std::make_pair(pair.first, pair.second));
+        for (const auto& pair : discarded)
+            pending.insert(std::make_pair(pair.first, pair.second));
+        return true;
+    }
+
+    template <typename Order>
+    bool PairQueue<Order>::has_lower_priority(const CriticalPair& a, const CriticalPair& b) const {
+        if (strategy == PairSelectionStrategy::DEGREE_SUGAR && a.lcm.get_degree() != b.lcm.get_degree())
+            return a.lcm.get_degree() > b.lcm.get_degree();
+        if ((strategy == PairSelectionStrategy::SUGAR || strategy == PairSelectionStrategy::DEGREE_SUGAR) &&
+            a.sugar != b.sugar)
+            return a.sugar > b.sugar;
+        if (strategy != PairSelectionStrategy::FIFO) {
+            int res = Order::cmp(a.lcm, b.lcm);
+            if (res != 0)
+                return res > 0;
+        }
+        return a.sequence_number > b.sequence_number;
+    }
+}
@@ -0,0 +1,246 @@
+#pragma once
+#include "algorithms.h"
+#include "critical_pairs.h"
+#include "sparse_matrix.h"
+#include "modular_elimination.h"
+#include <vector>
+#include <map>
+#include <set>
+#include <utility>
+#include <functional>
+
+namespace SALIB {
+    template <typename CoefficientType, typename Order = DefaultOrder>
+    class F4Alg {
+    public:
+        using PolynomialType = Polynomial<CoefficientType, Order>;
+        using PolySet = PolynomialSet<CoefficientType, Order>;
+        using Matrix = SparseMatrix<CoefficientType>;
+        // Sees every Macaulay matrix before its reduction, e.g. to dump it for benchmarks
+        using MatrixObserver = std::function<void(const Matrix&)>;
+
+        // Pairs are taken in batches of equal lcm degree, or of equal sugar for the sugar strategy.
+        // Matrices over Field<P> are reduced by ModularElimination on threads_count threads
+        inline static void make_groebner_basis(
+            std::vector<PolynomialType>& ideal,
+            PairSelectionStrategy strategy = PairSelectionStrategy::DEGREE_SUGAR,
+            const MatrixObserver& observer = MatrixObserver(),
+            size_t threads_count = 1
+        );
+
+        template <typename SetOrder>
+        inline static PolySet make_groebner_basis(
+            const PolynomialSet<CoefficientType, SetOrder>& ideal,
+            PairSelectionStrategy strategy = PairSelectionStrategy::DEGREE_SUGAR,
+            size_t threads_count = 1
+        );
+
+        inline static PolySet auto_reduce(const PolySet& ideal);
+
+    private:
+        using MonomialColumns = std::map<Monomial, size_t, Order>;
+        using RowSource = std::pair<size_t, Monomial>;  // Basis index and multiplier
+
+        inline static std::vector<CriticalPair> select_pairs(
+            PairQueue<Order>& pairs,
+            const std::vector<PolynomialType>& ideal
+        );
+
+        inline static std::vector<PolynomialType> reduce_pairs(
+            const std::vector<CriticalPair>& selected,
+            const std::vector<PolynomialType>& ideal,
+            const MatrixObserver& observer,
+            size_t threads_count
+        );
+
+        inline static void symbolic_preprocessing(
+            std::vector<PolynomialType>& rows,
+            MonomialColumns& columns,
+            const std::vector<PolynomialType>& ideal
+        );
+
+        inline static void add_row(
+            std::vector<PolynomialType>& rows,
+            std::set<RowSource>& sources,
+            const std::vector<PolynomialType>& ideal,
+            size_t index,
+            const Monomial& multiplier
+        );
+    };
+
+/*
+=================================IMPLEMENTATION=================================
+*/
+
+    template <typename CoefficientType, typename Order>
+    std::vector<CriticalPair> F4Alg<CoefficientType, Order>::select_pairs(
+            PairQueue<Order>& pairs,
+            const std::vector<PolynomialType>& ideal) {
+        std::vector<CriticalPair> selected;
+        bool by_sugar = pairs.get_strategy() == PairSelectionStrategy::SUGAR;
+        auto key = [by_sugar](const CriticalPair& pair) {
+            return by_sugar ? pair.sugar : pair.lcm.get_degree();
+        };
+        auto batch_key = key(pairs.top());
+        while (!pairs.empty() && key(pairs.top()) == batch_key) {
+            CriticalPair pair = pairs.pop();
+            if (!pairs.is_redundant(pair, ideal))
+                selected.push_back(std::move(pair));
+        }
+        return selected;
+    }
+
+    template <typename CoefficientType, typename Order>
+    void F4Alg<CoefficientType, Order>::add_row(
+            std::vector<PolynomialType>& rows,
+            std::set<RowSource>& sources,
+            const std::vector<PolynomialType>& ideal,
+            size_t index,
+            const Monomial& multiplier) {
+        if (sources.insert(RowSource(index, multiplier)).second)
+            rows.push_back(ideal[index] * PolynomialType(multiplier));
+    }
+
+    template <typename CoefficientType, typename Order>
+    void F4Alg<CoefficientType, Order>::symbolic_preprocessing(
+            std::vector<PolynomialType>& rows,
+            MonomialColumns& columns,
+            const std::vector<PolynomialType>& ideal) {
+        std::set<Monomial, Order> done;
+        std::vector<Monomial> todo;
+        for (const auto& row : rows)
+            done.insert(row.get_largest_monomial());
+        for (const auto& row : rows) {
+            for (const auto& it : row) {
+                if (columns.emplace(it.first, 0).second && !done.count(it.first))
+                    todo.push_back(it.first);
+            }
+        }
+
+        while (!todo.empty()) {
+            Monomial mono = std::move(todo.back());
+            todo.pop_back();
+            if (!done.insert(mono).second)
+                continue;
+            for (const auto& reducer : ideal) {
+                const Monomial& reducer_lt = reducer.get_largest_monomial();
+                if (reducer.is_zero() || !mono.is_dividable_by(reducer_lt))
+                    continue;
+                rows.push_back(reducer * PolynomialType(mono / reducer_lt));
+                for (const auto& it : rows.back()) {
+                    if (columns.emplace(it.first, 0).second && !done.count(it.first))
+                        todo.push_back(it.first);
+                }
+                break;
+            }
+        }
+
+        // Largest monomial gets the first column
+        size_t col = columns.size();
+        for (auto& it : columns)
+            it.second = --col;
+    }
+
+    template <typename CoefficientType, typename Order>
+    std::vector<typename F4Alg<CoefficientType, Order>::PolynomialType>
+    F4Alg<CoefficientType, Order>::reduce_pairs(
+            const std::vector<CriticalPair>& selected,
+            const std::vector<PolynomialType>& ideal,
+            const MatrixObserver& observer,
+            size_t threads_count) {
+        std::vector<PolynomialType> rows;
+        std::set<RowSource> sources;
+        for (const auto& pair : selected) {
+            add_row(rows, sources, ideal, pair.first, pair.lcm / ideal[pair.first].get_largest_monomial());
+            add_row(rows, sources, ideal, pair.second, pair.lcm / ideal[pair.second].get_largest_monomial());
+        }
+
+        MonomialColumns columns;
+        symbolic_preprocessing(rows, columns, ideal);
+
+        std::vector<Monomial> column_monomials(columns.size());
+        for (const auto& it : columns)
+            column_monomials[it.second] = it.first;
+
+        Matrix matrix(columns.size());
+        std::set<size_t> leading_columns;
+        for (const auto& row : rows) {
+            typename Matrix::Row sparse_row;
+            sparse_row.reserve(std::distance(row.begin(), row.end()));
+            for (auto it = row.rbegin(); it != row.rend(); ++it)
+                sparse_row.emplace_back(columns[it->first], it->second);
+            if (!sparse_row.empty())
+                leading_columns.insert(sparse_row.front().first);
+            matrix.add_row(std::move(sparse_row));
+        }
+        rows.clear();
+
+        if (observer)
+            observer(matrix);
+        row_echelon_form(matrix, threads_count);
+
+        std::vector<PolynomialType> new_elements;
+        for (const auto& row : matrix) {
+            if (leading_columns.count(row.front().first))
+                continue;
+            PolynomialType poly;
+            for (const auto& entry : row)
+                poly += PolynomialType(entry.second, column_monomials[entry.first]);
+            new_elements.push_back(std::move(poly));
+        }
+        return new_elements;
+    }
+
+    template <typename CoefficientType, typename Order>
+    void F4Alg<CoefficientType, Order>::make_groebner_basis(
+            std::vector<PolynomialType>& ideal,
+            PairSelectionStrategy strategy,
+            const MatrixObserver& observer,
+            size_t threads_count) {
+        if (strategy != PairSelectionStrategy::SUGAR)
+            strategy = PairSelectionStrategy::DEGREE_SUGAR;
+        PairQueue<Order> pairs(strategy);
+        for (size_t idx = 0; idx < ideal.size(); ++idx)
+            pairs.add_element(ideal);
+
+        while (!pairs.empty()) {
+            std::vector<CriticalPair> selected = select_pairs(pairs, ideal);
+            if (selected.empty())
+                continue;
+            CriticalPair::SugarType batch_sugar = 0;
+            for (const auto& pair : selected)
+                batch_sugar = std::max(batch_sugar, pair.sugar);
+
+            for (auto& poly : reduce_pairs(selected, ideal, observer, threads_count)) {
+                ideal.push_back(std::move(poly));
+                pairs.add_element(ideal, std::max(batch_sugar, PairQueue<Order>::get_total_degree(ideal.back())));
+            }
+        }
+    }
+
+    template <typename CoefficientType, typename Order>
+    template <typename SetOrder>
+    typename F4Alg<CoefficientType, Order>::PolySet
+    F4Alg<CoefficientType, Order>::make_groebner_basis(
+            const PolynomialSet<CoefficientType, SetOrder>& ideal,
+            PairSelectionStrategy strategy,
+            size_t threads_count) {
+        std::vector<PolynomialType> new_ideal;
+        new_ideal.reserve(ideal.size());
+        for (const auto& p : ideal) {
+            new_ideal.push_back(PolynomialType(p));
+        }
+        make_groebner_basis(new_ideal, strategy, MatrixObserver(), threads_count);
+        PolySet basis;
+        for (const auto& p : new_ideal) {
+            basis.add(p);
+        }
+        return basis;
+    }
+
+    template <typename CoefficientType, typename Order>
+    typename F4Alg<CoefficientType, Order>::PolySet
+    F4Alg<CoefficientType, Order>::auto_reduce(const PolySet& ideal) {
+        return PolyAlg<CoefficientType, Order>::auto_reduce(ideal);
+    }
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include <iostream>
+#include <utility>
 #include <boost/functional/hash.hpp>
 
 namespace SALIB {
@@ -7,7 +8,19 @@ namespace SALIB {
     template <int N = 2>
     struct Field {
         unsigned long long n;
-        static const unsigned long long inv[N];
+
+        // N must be prime, the inverse comes from the extended Euclidean algorithm
+        inline static unsigned long long inverse(unsigned long long value) {
+            long long a = value % N, b = N, x = 1, y = 0;
+            while (b != 0) {
+                long long q = a / b;
+                a -= q * b;
+                std::swap(a, b);
+                x -= q * y;
+                std::swap(x, y);
+            }
+            return static_cast<unsigned long long>((x % N + N) % N);
+        }
 
         Field() : n(0) {}
 
@@ -31,7 +44,7 @@ namespace SALIB {
             return *this;
         }
 
-        inline Field &operator/=(const Field &other) { return (*this) *= Field(inv[other.n]); }
+        inline Field &operator/=(const Field &other) { return (*this) *= Field(inverse(other.n)); }
 
         inline Field operator*(const Field &other) const {
             Field res(*this);
@@ -77,9 +90,6 @@ namespace SALIB {
         }
     };
 
-    template <int N>
-    const unsigned long long Field<N>::inv[N] = {0, 1};// , 3, 2, 4};
-
     template <int N>
     inline std::ostream &operator<<(std::ostream &out, const Field<N> &f) { return out << f.n; }
 
@@ -0,0 +1,203 @@
+#pragma once
+#include "algorithms.h"
+#include "critical_pairs.h"
+#include <vector>
+#include <utility>
+
+namespace SALIB {
+    // Groebner basis of an ideal that keeps its pair queue, so new generators continue the computation
+    template <typename CoefficientType, typename Order = DefaultOrder>
+    class GroebnerBasis {
+    public:
+        using PolynomialType = Polynomial<CoefficientType, Order>;
+        using PolySet = PolynomialSet<CoefficientType, Order>;
+
+        inline explicit GroebnerBasis(PairSelectionStrategy strategy = PairSelectionStrategy::NORMAL);
+
+        template <typename SetOrder>
+        inline explicit GroebnerBasis(
+            const PolynomialSet<CoefficientType, SetOrder>& ideal,
+            PairSelectionStrategy strategy = PairSelectionStrategy::NORMAL
+        );
+
+        // Returns false if the polynomial already lies in the ideal and nothing changed
+        inline bool add_generator(const PolynomialType& poly);
+
+        template <typename SetOrder>
+        inline void add_generators(const PolynomialSet<CoefficientType, SetOrder>& ideal);
+
+        // Normal form, zero exactly for the members of the ideal
+        inline PolynomialType reduce(const PolynomialType& poly) const;
+        inline bool contains(const PolynomialType& poly) const;
+
+        // Normal forms of f, f^2, ..., f^max_power are tried first. Only then the Rabinowitsch trick runs
+        // on a copy of the current state, it stops as soon as 1 appears. This basis is left untouched
+        inline bool is_polynomial_in_radical(
+            const PolynomialType& poly,
+            Monomial::VariableIndexType free_variable,
+            size_t max_power = 4
+        ) const;
+
+        inline bool is_unit() const;
+
+        inline const std::vector<PolynomialType>& get_polynomials() const;
+        inline const std::vector<PolynomialType>& get_reducers() const;
+        inline PolySet get_reduced_basis() const;
+
+        inline size_t size() const;
+
+    private:
+        using Alg = PolyAlg<CoefficientType, Order>;
+
+        inline void push(PolynomialType poly, CriticalPair::SugarType sugar);
+        inline void complete();
+
+        std::vector<PolynomialType> basis;
+        PairQueue<Order> pairs;
+        // Elements with minimal leading monomials, enough to reduce by the whole basis
+        std::vector<PolynomialType> reducers;
+    };
+
+/*
+=================================IMPLEMENTATION=================================
+*/
+
+    template <typename CoefficientType, typename Order>
+    GroebnerBasis<CoefficientType, Order>::GroebnerBasis(PairSelectionStrategy strategy) : pairs(strategy) {}
+
+    template <typename CoefficientType, typename Order>
+    template <typename SetOrder>
+    GroebnerBasis<CoefficientType, Order>::GroebnerBasis(
+            const PolynomialSet<CoefficientType, SetOrder>& ideal,
+            PairSelectionStrategy strategy) : pairs(strategy) {
+        add_generators(ideal);
+    }
+
+    template <typename CoefficientType, typename Order>
+    void GroebnerBasis<CoefficientType, Order>::push(PolynomialType poly, CriticalPair::SugarType sugar) {
+        if (Alg::is_nonzero_constant(poly)) {
+            // The unit ideal: the remaining pairs are dropped
+            basis.assign(1, PolynomialType(CoefficientType(1)));
+            reducers = basis;
+            pairs = PairQueue<Order>(pairs.get_strategy());
+            pairs.add_element(basis, 0);
+            return;
+        }
+        const Monomial& lt = poly.get_largest_monomial();
+        for (size_t idx = 0; idx < reducers.size();) {
+            if (reducers[idx].get_largest_monomial().is_dividable_by(lt)) {
+                reducers[idx] = std::move(reducers.back());
+                reducers.pop_back();
+            } else {
+                ++idx;
+            }
+        }
+        reducers.push_back(poly);
+        basis.push_back(std::move(poly));
+        pairs.add_element(basis, sugar);
+    }
+
+    template <typename CoefficientType, typename Order>
+    void GroebnerBasis<CoefficientType, Order>::complete() {
+        while (!pairs.empty()) {
+            CriticalPair pair = pairs.pop();
+            if (pairs.is_redundant(pair, basis))
+                continue;
+
+            PolynomialType s = PolynomialType::s_polynomial(basis[pair.first], basis[pair.second]);
+            s = Alg::reduce_by(s, reducers);
+            if (!s.is_zero()) {
+                CriticalPair::SugarType sugar = std::max(pair.sugar, PairQueue<Order>::get_total_degree(s));
+                push(std::move(s), sugar);
+            }
+        }
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool GroebnerBasis<CoefficientType, Order>::add_generator(const PolynomialType& poly) {
+        PolynomialType reduced = reduce(poly);
+        if (reduced.is_zero())
+            return false;
+        push(reduced, PairQueue<Order>::get_total_degree(poly));
+        complete();
+        return true;
+    }
+
+    template <typename CoefficientType, typename Order>
+    template <typename SetOrder>
+    void GroebnerBasis<CoefficientType, Order>::add_generators(const PolynomialSet<CoefficientType, SetOrder>& ideal) {
+        // All generators are registered before the pairs are processed
+        for (const auto& p : ideal) {
+            PolynomialType poly(p);
+            PolynomialType reduced = reduce(poly);
+            if (!reduced.is_zero())
+                push(std::move(reduced), PairQueue<Order>::get_total_degree(poly));
+        }
+        complete();
+    }
+
+    template <typename CoefficientType, typename Order>
+    typename GroebnerBasis<CoefficientType, Order>::PolynomialType
+    GroebnerBasis<CoefficientType, Order>::reduce(const PolynomialType& poly) const {
+        return Alg::reduce_by(poly, reducers);
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool GroebnerBasis<CoefficientType, Order>::contains(const PolynomialType& poly) const {
+        return reduce(poly).is_zero();
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool GroebnerBasis<CoefficientType, Order>::is_polynomial_in_radical(
+            const PolynomialType& poly,
+            Monomial::VariableIndexType free_variable,
+            size_t max_power) const {
+        // NF(f^k) = NF(NF(f^(k - 1)) * f), so the powers never grow beyond one multiplication
+        PolynomialType power = reduce(poly);
+        for (size_t k = 1; k <= max_power; ++k) {
+            if (power.is_zero())
+                return true;
+            if (k < max_power)
+                power = reduce(power * poly);
+        }
+
+        PolynomialType t = PolynomialType(CoefficientType(1), Monomial(free_variable, 1));
+        PolynomialType one = PolynomialType(CoefficientType(1));
+        GroebnerBasis extended(*this);
+        extended.add_generator(one - t * poly);
+        return extended.is_unit();
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool GroebnerBasis<CoefficientType, Order>::is_unit() const {
+        return basis.size() == 1 && Alg::is_nonzero_constant(basis.front());
+    }
+
+    template <typename CoefficientType, typename Order>
+    const std::vector<typename GroebnerBasis<CoefficientType, Order>::PolynomialType>&
+    GroebnerBasis<CoefficientType, Order>::get_polynomials() const {
+        return basis;
+    }
+
+    template <typename CoefficientType, typename Order>
+    const std::vector<typename GroebnerBasis<CoefficientType, Order>::PolynomialType>&
+    GroebnerBasis<CoefficientType, Order>::get_reducers() const {
+        return reducers;
+    }
+
+    template <typename CoefficientType, typename Order>
+    typename GroebnerBasis<CoefficientType, Order>::PolySet
+    GroebnerBasis<CoefficientType, Order>::get_reduced_basis() const {
+        std::vector<PolynomialType> polys(reducers);
+        Alg::interreduce(polys);
+        PolySet res;
+        for (const auto& poly : polys)
+            res.add(poly);
+        return res;
+    }
+
+    template <typename CoefficientType, typename Order>
+    size_t GroebnerBasis<CoefficientType, Order>::size() const {
+        return basis.size();
+    }
+}
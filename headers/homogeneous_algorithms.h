@@ -0,0 +1,219 @@
+#pragma once
+#include "algorithms.h"
+#include "critical_pairs.h"
+#include "computation_context.h"
+#include "thread_pool.h"
+#include <vector>
+#include <memory>
+#include <utility>
+#include <algorithm>
+
+namespace SALIB {
+    // Experimental, nothing selects it automatically: it was slower than PolyAlg on Katsura8 (35.0 s vs 30.7 s)
+    // and Alea6 (140 s vs 84-105 s).
+    // Buchberger on the homogenized ideal. Pairs are processed strictly degree by degree: all pairs
+    // and generators of degree d form one batch, reduced by the basis of degree < d (concurrently
+    // if threads_count > 1). The result is dehomogenized and interreduced. For an Order that is not graded
+    // the dehomogenized basis is no basis in Order, so such orders go to PolyAlg directly
+    template <typename CoefficientType, typename Order = DefaultOrder>
+    class HomogenizedPolyAlg {
+    public:
+        using PolynomialType = Polynomial<CoefficientType, Order>;
+        using PolySet = PolynomialSet<CoefficientType, Order>;
+        using HomogeneousOrder = HomogenizedOrder<Order>;
+        using HomogeneousPolynomial = Polynomial<CoefficientType, HomogeneousOrder>;
+
+        // Progress reports the degree of the current batch. A stopped computation leaves
+        // the dehomogenized partial basis in ideal
+        inline static void make_groebner_basis(
+            std::vector<PolynomialType>& ideal,
+            size_t threads_count = 1,
+            ComputationContext* context = nullptr
+        );
+
+        template <typename SetOrder>
+        inline static PolySet make_groebner_basis(
+            const PolynomialSet<CoefficientType, SetOrder>& ideal,
+            size_t threads_count = 1,
+            ComputationContext* context = nullptr
+        );
+
+        // The homogenizing variable takes index 0, the variables of poly are shifted by one
+        inline static HomogeneousPolynomial homogenize(const PolynomialType& poly);
+        inline static PolynomialType dehomogenize(const HomogeneousPolynomial& poly);
+
+    private:
+        using HomogeneousAlg = PolyAlg<CoefficientType, HomogeneousOrder>;
+
+        inline static void complete(
+            std::vector<HomogeneousPolynomial> generators,
+            std::vector<HomogeneousPolynomial>& basis,
+            size_t threads_count,
+            ComputationContext* context
+        );
+    };
+
+/*
+=================================IMPLEMENTATION=================================
+*/
+
+    template <typename CoefficientType, typename Order>
+    typename HomogenizedPolyAlg<CoefficientType, Order>::HomogeneousPolynomial
+    HomogenizedPolyAlg<CoefficientType, Order>::homogenize(const PolynomialType& poly) {
+        Monomial::VariableDegreeType degree = PairQueue<Order>::get_total_degree(poly);
+        HomogeneousPolynomial res;
+        for (const auto& term : poly) {
+            Monomial mono(0, degree - term.first.get_degree());
+            for (size_t var = 0; var < static_cast<size_t>(term.first.end() - term.first.begin()); ++var) {
+                if (term.first[var] != 0)
+                    mono.set_var_degree(var + 1, term.first[var]);
+            }
+            res += HomogeneousPolynomial(term.second, mono);
+        }
+        return res;
+    }
+
+    template <typename CoefficientType, typename Order>
+    typename HomogenizedPolyAlg<CoefficientType, Order>::PolynomialType
+    HomogenizedPolyAlg<CoefficientType, Order>::dehomogenize(const HomogeneousPolynomial& poly) {
+        PolynomialType res;
+        for (const auto& term : poly) {
+            Monomial mono;
+            for (size_t var = 1; var < static_cast<size_t>(term.first.end() - term.first.begin()); ++var) {
+                if (term.first[var] != 0)
+                    mono.set_var_degree(var - 1, term.first[var]);
+            }
+            res += PolynomialType(term.second, mono);
+        }
+        return res;
+    }
+
+    template <typename CoefficientType, typename Order>
+    void HomogenizedPolyAlg<CoefficientType, Order>::complete(
+            std::vector<HomogeneousPolynomial> generators,
+            std::vector<HomogeneousPolynomial>& basis,
+            size_t threads_count,
+            ComputationContext* context) {
+        using Degree = Monomial::VariableDegreeType;
+        // Generators enter the computation at their own degree, the smallest one at the back
+        std::sort(generators.begin(), generators.end(), [](const HomogeneousPolynomial& a, const HomogeneousPolynomial& b) {
+            return a.get_largest_monomial().get_degree() > b.get_largest_monomial().get_degree();
+        });
+        PairQueue<HomogeneousOrder> pairs(PairSelectionStrategy::DEGREE_SUGAR);
+        std::unique_ptr<ThreadPool> pool;
+        if (threads_count > 1)
+            pool.reset(new ThreadPool(threads_count));
+
+        while (!pairs.empty() || !generators.empty()) {
+            Degree degree = generators.empty() ? pairs.top().lcm.get_degree()
+                                               : generators.back().get_largest_monomial().get_degree();
+            if (!pairs.empty())
+                degree = std::min(degree, pairs.top().lcm.get_degree());
+
+            // The batch of degree d: S-polynomials of its pairs and generators of degree d
+            std::vector<CriticalPair> selected;
+            while (!pairs.empty() && pairs.top().lcm.get_degree() == degree) {
+                CriticalPair pair = pairs.pop();
+                if (!pairs.is_redundant(pair, basis))
+                    selected.push_back(std::move(pair));
+            }
+            std::vector<HomogeneousPolynomial> batch;
+            while (!generators.empty() && generators.back().get_largest_monomial().get_degree() == degree) {
+                batch.push_back(std::move(generators.back()));
+                generators.pop_back();
+            }
+            const size_t generators_in_batch = batch.size();
+            batch.resize(generators_in_batch + selected.size());
+
+            // Elements of degree d can not reduce each other's pairs, so the basis is fixed meanwhile
+            const std::vector<HomogeneousPolynomial>& reducers = basis;
+            auto reduce_item = [&reducers, &selected, &batch, generators_in_batch](size_t idx) {
+                HomogeneousPolynomial& poly = batch[idx];
+                if (idx >= generators_in_batch) {
+                    const CriticalPair& pair = selected[idx - generators_in_batch];
+                    poly = HomogeneousPolynomial::s_polynomial(reducers[pair.first], reducers[pair.second]);
+                }
+                poly = HomogeneousAlg::reduce_by(poly, reducers);
+            };
+            if (pool) {
+                for (size_t idx = 0; idx < batch.size(); ++idx)
+                    pool->submit([&reduce_item, idx] { reduce_item(idx); });
+                pool->wait();
+            } else {
+                for (size_t idx = 0; idx < batch.size(); ++idx)
+                    reduce_item(idx);
+            }
+
+            // New elements of the batch still reduce each other
+            std::vector<HomogeneousPolynomial> fresh;
+            for (auto& poly : batch) {
+                if (poly.is_zero())
+                    continue;
+                if (!fresh.empty()) {
+                    poly = HomogeneousAlg::reduce_by(poly, fresh);
+                    if (poly.is_zero())
+                        continue;
+                }
+                fresh.push_back(poly);
+                basis.push_back(std::move(poly));
+                pairs.add_element(basis, degree);
+            }
+
+            if (context) {
+                for (size_t idx = 0; idx < selected.size(); ++idx)
+                    context->on_pair_processed(pairs.size(), basis.size(), degree);
+                if (context->should_stop())
+                    return;
+            }
+        }
+    }
+
+    template <typename CoefficientType, typename Order>
+    void HomogenizedPolyAlg<CoefficientType, Order>::make_groebner_basis(
+            std::vector<PolynomialType>& ideal,
+            size_t threads_count,
+            ComputationContext* context) {
+        using Alg = PolyAlg<CoefficientType, Order>;
+        if (!IsGradedOrder<Order>::value) {
+            Alg::make_groebner_basis(ideal, PairSelectionStrategy::NORMAL, context);
+            if (!context || !context->is_stopped())
+                Alg::interreduce(ideal);
+            return;
+        }
+
+        std::vector<HomogeneousPolynomial> generators;
+        for (const auto& poly : ideal) {
+            if (!poly.is_zero())
+                generators.push_back(homogenize(poly));
+        }
+        std::vector<HomogeneousPolynomial> basis;
+        complete(std::move(generators), basis, threads_count, context);
+
+        ideal.clear();
+        for (const auto& poly : basis)
+            ideal.push_back(dehomogenize(poly));
+        if (context && context->is_stopped())
+            return;
+        if (context)
+            context->finish();
+        Alg::interreduce(ideal);
+    }
+
+    template <typename CoefficientType, typename Order>
+    template <typename SetOrder>
+    typename HomogenizedPolyAlg<CoefficientType, Order>::PolySet
+    HomogenizedPolyAlg<CoefficientType, Order>::make_groebner_basis(
+            const PolynomialSet<CoefficientType, SetOrder>& ideal,
+            size_t threads_count,
+            ComputationContext* context) {
+        std::vector<PolynomialType> new_ideal;
+        new_ideal.reserve(ideal.size());
+        for (const auto& p : ideal)
+            new_ideal.push_back(PolynomialType(p));
+        make_groebner_basis(new_ideal, threads_count, context);
+        PolySet basis;
+        for (const auto& p : new_ideal)
+            basis.add(p);
+        return basis;
+    }
+}
@@ -0,0 +1,476 @@
+#pragma once
+#include "polynomial.h"
+#include "polynomial_set.h"
+#include "mapped_file.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <istream>
+#include <iterator>
+#include <utility>
+#include <algorithm>
+
+namespace SALIB {
+    // A system in the syntax of test_launcher/tests.txt:
+    //   # name
+    //   # description
+    //   var := [x, y]:
+    //   sys := [x^2 - 3*x*y, 123456789012345678901234567890*y + 1/2]:
+    template <typename CoefficientType, typename Order = DefaultOrder>
+    struct MapleSystem {
+        std::string name;
+        std::string description;
+        // Names by variable index
+        std::vector<std::string> variables;
+        std::vector<Polynomial<CoefficientType, Order>> polynomials;
+    };
+
+    // Reads the systems of a buffer one by one in a single pass. Integers of any length are accumulated
+    // in CoefficientType by Horner's rule, the terms of a polynomial are collected and inserted at once
+    template <typename CoefficientType, typename Order = DefaultOrder>
+    class MapleReader {
+    public:
+        using PolynomialType = Polynomial<CoefficientType, Order>;
+        using PolySet = PolynomialSet<CoefficientType, Order>;
+        using System = MapleSystem<CoefficientType, Order>;
+
+        // The data is not copied and must outlive the reader
+        inline MapleReader(const char* data, size_t size);
+        // The rest of the stream, e.g. stdin, is read into the reader
+        inline explicit MapleReader(std::istream& in);
+        // The file is mapped and read in place
+        inline explicit MapleReader(const std::string& filename);
+
+        // Fixes the index of a variable name, other variables get their position in the var list
+        inline void set_variable_index(const std::string& name, Monomial::VariableIndexType index);
+
+        // Returns false at the end of the input or on a syntax error
+        inline bool read_system(System& system);
+        inline bool read_system(PolySet& system);
+
+        inline bool has_error() const;
+        // The message names the line of the error
+        inline const std::string& get_error() const;
+
+    private:
+        using Term = typename PolynomialType::Term;
+        using Factor = std::pair<Monomial::VariableIndexType, Monomial::VariableDegreeType>;
+
+        struct NameSlot {
+            std::string name;
+            Monomial::VariableIndexType index = 0;
+            bool used = false;
+        };
+
+        // Plain ASCII classes, the locale of std::isdigit does not matter for the syntax
+        inline static bool is_digit(char symbol);
+        inline static bool is_name_start(char symbol);
+        inline void skip_spaces();
+        inline bool fail(const std::string& message);
+        inline bool expect(char symbol);
+        inline bool expect_word(const char* word);
+        inline bool expect_terminator();
+        inline bool skip_identifier();
+        inline bool read_identifier(std::string& name);
+        inline static size_t hash_name(const char* first, const char* last);
+        inline void add_variable(const std::string& name, Monomial::VariableIndexType index);
+        inline bool find_variable(const char* first, const char* last, Monomial::VariableIndexType& index) const;
+        inline bool read_unsigned(Monomial::VariableDegreeType& value);
+        inline bool read_integer(CoefficientType& value);
+        inline bool read_variables(System& system);
+        inline bool read_term(Term& term);
+        inline bool read_polynomial(PolynomialType& poly);
+
+        const char* begin;
+        const char* position;
+        const char* end;
+        std::string buffer;
+        MappedFile file;
+        std::unordered_map<std::string, Monomial::VariableIndexType> fixed_indices;
+        // Open addressing table of the current var list, identifiers are looked up without a copy
+        std::vector<NameSlot> variable_slots;
+        std::vector<Factor> factors;
+        std::string identifier;
+        std::string error;
+    };
+
+/*
+=================================IMPLEMENTATION=================================
+*/
+
+    template <typename CoefficientType, typename Order>
+    MapleReader<CoefficientType, Order>::MapleReader(const char* data, size_t size)
+            : begin(data), position(data), end(data + size) {}
+
+    template <typename CoefficientType, typename Order>
+    MapleReader<CoefficientType, Order>::MapleReader(std::istream& in)
+            : buffer(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()) {
+        begin = position = buffer.data();
+        end = begin + buffer.size();
+    }
+
+    template <typename CoefficientType, typename Order>
+    MapleReader<CoefficientType, Order>::MapleReader(const std::string& filename)
+            : begin(nullptr), position(nullptr), end(nullptr) {
+        if (!file.open(filename)) {
+            error = "can not map " + filename;
+            return;
+        }
+        begin = position = static_cast<const char*>(file.data());
+        end = begin + file.size();
+    }
+
+    template <typename CoefficientType, typename Order>
+    void MapleReader<CoefficientType, Order>::set_variable_index(
+            const std::string& name,
+            Monomial::VariableIndexType index) {
+        fixed_indices[name] = index;
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool MapleReader<CoefficientType, Order>::has_error() const {
+        return !error.empty();
+    }
+
+    template <typename CoefficientType, typename Order>
+    const std::string& MapleReader<CoefficientType, Order>::get_error() const {
+        return error;
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool MapleReader<CoefficientType, Order>::is_digit(char symbol) {
+        return symbol >= '0' && symbol <= '9';
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool MapleReader<CoefficientType, Order>::is_name_start(char symbol) {
+        return (symbol >= 'a' && symbol <= 'z') || (symbol >= 'A' && symbol <= 'Z') || symbol == '_';
+    }
+
+    template <typename CoefficientType, typename Order>
+    void MapleReader<CoefficientType, Order>::skip_spaces() {
+        while (position != end && (*position == ' ' || *position == '\n' || *position == '\t' || *position == '\r'))
+            ++position;
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool MapleReader<CoefficientType, Order>::fail(const std::string& message) {
+        size_t line = 1 + std::count(begin, position, '\n');
+        error = "line " + std::to_string(line) + ": " + message;
+        // Nothing more is read after an error
+        position = end;
+        return false;
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool MapleReader<CoefficientType, Order>::expect(char symbol) {
+        skip_spaces();
+        if (position == end || *position != symbol)
+            return fail(std::string("expected '") + symbol + "'");
+        ++position;
+        return true;
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool MapleReader<CoefficientType, Order>::expect_word(const char* word) {
+        skip_spaces();
+        if (!read_identifier(identifier) || identifier != word)
+            return fail(std::string("expected ") + word);
+        skip_spaces();
+        if (end - position < 2 || position[0] != ':' || position[1] != '=')
+            return fail("expected :=");
+        position += 2;
+        return true;
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool MapleReader<CoefficientType, Order>::expect_terminator() {
+        skip_spaces();
+        if (position == end || (*position != ':' && *position != ';'))
+            return fail("expected ':' or ';'");
+        ++position;
+        return true;
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool MapleReader<CoefficientType, Order>::skip_identifier() {
+        if (position == end || !is_name_start(*position))
+            return false;
+        while (position != end && (is_name_start(*position) || is_digit(*position)))
+            ++position;
+        return true;
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool MapleReader<CoefficientType, Order>::read_identifier(std::string& name) {
+        const char* start = position;
+        if (!skip_identifier())
+            return false;
+        name.assign(start, position);
+        return true;
+    }
+
+    template <typename CoefficientType, typename Order>
+    size_t MapleReader<CoefficientType, Order>::hash_name(const char* first, const char* last) {
+        size_t hash = 14695981039346656037ULL;
+        for (; first != last; ++first)
+            hash = (hash ^ static_cast<unsigned char>(*first)) * 1099511628211ULL;
+        return hash;
+    }
+
+    template <typename CoefficientType, typename Order>
+    void MapleReader<CoefficientType, Order>::add_variable(const std::string& name, Monomial::VariableIndexType index) {
+        size_t mask = variable_slots.size() - 1;
+        size_t slot = hash_name(name.data(), name.data() + name.size()) & mask;
+        while (variable_slots[slot].used && variable_slots[slot].name != name)
+            slot = (slot + 1) & mask;
+        variable_slots[slot].name = name;
+        variable_slots[slot].index = index;
+        variable_slots[slot].used = true;
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool MapleReader<CoefficientType, Order>::find_variable(
+            const char* first,
+            const char* last,
+            Monomial::VariableIndexType& index) const {
+        size_t mask = variable_slots.size() - 1;
+        size_t length = static_cast<size_t>(last - first);
+        for (size_t slot = hash_name(first, last) & mask; variable_slots[slot].used; slot = (slot + 1) & mask) {
+            const std::string& name = variable_slots[slot].name;
+            if (name.size() == length && std::equal(first, last, name.begin())) {
+                index = variable_slots[slot].index;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool MapleReader<CoefficientType, Order>::read_unsigned(Monomial::VariableDegreeType& value) {
+        skip_spaces();
+        if (position == end || !is_digit(*position))
+            return fail("expected an exponent");
+        value = 0;
+        while (position != end && is_digit(*position))
+            value = value * 10 + (*position++ - '0');
+        return true;
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool MapleReader<CoefficientType, Order>::read_integer(CoefficientType& value) {
+        // Up to 18 digits fit a long long, longer numbers are added to value chunk by chunk
+        const int CHUNK_DIGITS = 18;
+        bool first_chunk = true;
+        while (position != end && is_digit(*position)) {
+            long long chunk = 0, scale = 1;
+            for (int digits = 0; digits < CHUNK_DIGITS && position != end &&
+                                 is_digit(*position); ++digits) {
+                chunk = chunk * 10 + (*position++ - '0');
+                scale *= 10;
+            }
+            if (first_chunk)
+                value = CoefficientType(chunk);
+            else
+                value = value * CoefficientType(scale) + CoefficientType(chunk);
+            first_chunk = false;
+        }
+        if (first_chunk)
+            return fail("expected a number");
+        return true;
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool MapleReader<CoefficientType, Order>::read_variables(System& system) {
+        if (!expect_word("var") || !expect('['))
+            return false;
+        std::vector<std::string> names;
+        skip_spaces();
+        if (position != end && *position == ']') {
+            ++position;
+        } else {
+            while (true) {
+                skip_spaces();
+                names.emplace_back();
+                if (!read_identifier(names.back()))
+                    return fail("expected a variable name");
+                skip_spaces();
+                if (position != end && *position == ',') {
+                    ++position;
+                    continue;
+                }
+                if (!expect(']'))
+                    return false;
+                break;
+            }
+        }
+        // At most half of the slots are used, so a lookup ends at an empty slot
+        size_t slots = 2;
+        while (slots < 2 * names.size())
+            slots *= 2;
+        variable_slots.assign(slots, NameSlot());
+        for (size_t idx = 0; idx < names.size(); ++idx) {
+            auto fixed = fixed_indices.find(names[idx]);
+            Monomial::VariableIndexType index = fixed == fixed_indices.end() ? idx : fixed->second;
+            add_variable(names[idx], index);
+            if (system.variables.size() <= index)
+                system.variables.resize(index + 1);
+            system.variables[index] = names[idx];
+        }
+        return true;
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool MapleReader<CoefficientType, Order>::read_term(Term& term) {
+        // Factors are numbers and powers of variables joined by '*', a number may follow '/'
+        bool has_coefficient = false;
+        CoefficientType& coeff = term.second;
+        CoefficientType number;
+        factors.clear();
+        while (true) {
+            skip_spaces();
+            if (position == end)
+                return fail("unexpected end of input");
+            if (is_digit(*position)) {
+                if (!read_integer(number))
+                    return false;
+                if (has_coefficient)
+                    coeff *= number;
+                else
+                    coeff = number;
+                has_coefficient = true;
+            } else {
+                const char* name = position;
+                if (!skip_identifier())
+                    return fail("expected a number or a variable");
+                Monomial::VariableIndexType var;
+                if (!find_variable(name, position, var))
+                    return fail("unknown variable " + std::string(name, position));
+                Monomial::VariableDegreeType degree = 1;
+                skip_spaces();
+                if (position != end && *position == '^') {
+                    ++position;
+                    if (!read_unsigned(degree))
+                        return false;
+                }
+                factors.emplace_back(var, degree);
+            }
+
+            skip_spaces();
+            if (position != end && *position == '/') {
+                ++position;
+                skip_spaces();
+                if (!read_integer(number))
+                    return false;
+                if (number == CoefficientType(0))
+                    return fail("division by zero");
+                if (!has_coefficient)
+                    coeff = CoefficientType(1);
+                coeff /= number;
+                has_coefficient = true;
+                skip_spaces();
+            }
+            if (position == end || *position != '*')
+                break;
+            ++position;
+        }
+        if (!has_coefficient)
+            coeff = CoefficientType(1);
+        // The largest variable goes first, so the exponents are allocated once
+        if (!factors.empty()) {
+            auto last = std::max_element(factors.begin(), factors.end());
+            term.first = Monomial(last->first, last->second);
+            const Monomial& mono = term.first;
+            for (auto it = factors.begin(); it != factors.end(); ++it) {
+                if (it != last)
+                    term.first.set_var_degree(it->first, mono[it->first] + it->second);
+            }
+        }
+        return true;
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool MapleReader<CoefficientType, Order>::read_polynomial(PolynomialType& poly) {
+        std::vector<Term> terms;
+        skip_spaces();
+        bool first = true;
+        while (true) {
+            skip_spaces();
+            bool negative = false;
+            if (position != end && (*position == '+' || *position == '-')) {
+                negative = *position == '-';
+                ++position;
+            } else if (!first) {
+                break;
+            }
+            first = false;
+            terms.emplace_back();
+            if (!read_term(terms.back()))
+                return false;
+            if (negative)
+                terms.back().second = -terms.back().second;
+        }
+        poly = PolynomialType::from_terms(std::move(terms));
+        return true;
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool MapleReader<CoefficientType, Order>::read_system(System& system) {
+        system = System();
+        // Comment lines before a system hold its name and description
+        while (true) {
+            skip_spaces();
+            if (position == end || *position != '#')
+                break;
+            const char* line_end = std::find(position, end, '\n');
+            const char* text = position + 1;
+            while (text != line_end && *text == ' ')
+                ++text;
+            std::string comment(text, line_end);
+            if (!comment.empty() && comment.back() == '\r')
+                comment.pop_back();
+            if (system.name.empty())
+                system.name = comment;
+            else if (system.description.empty())
+                system.description = comment;
+            position = line_end;
+        }
+        if (position == end)
+            return false;
+
+        if (!read_variables(system) || !expect_terminator() || !expect_word("sys") || !expect('['))
+            return false;
+        skip_spaces();
+        if (position != end && *position == ']') {
+            ++position;
+        } else {
+            while (true) {
+                system.polynomials.emplace_back();
+                if (!read_polynomial(system.polynomials.back()))
+                    return false;
+                skip_spaces();
+                if (position != end && *position == ',') {
+                    ++position;
+                    continue;
+                }
+                if (!expect(']'))
+                    return false;
+                break;
+            }
+        }
+        return expect_terminator();
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool MapleReader<CoefficientType, Order>::read_system(PolySet& system) {
+        System parsed;
+        if (!read_system(parsed))
+            return false;
+        system.clear();
+        for (const auto& poly : parsed.polynomials) {
+            if (!poly.is_zero())
+                system.add(poly);
+        }
+        return true;
+    }
+}
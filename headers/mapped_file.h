@@ -0,0 +1,72 @@
+#pragma once
+#include <string>
+#include <cstddef>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace SALIB {
+    // Read-only private mapping of a whole file, pages are shared with every other process mapping it
+    class MappedFile {
+    public:
+        inline MappedFile();
+        inline ~MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        inline bool open(const std::string& filename);
+        inline void close();
+
+        inline const void* data() const;
+        inline size_t size() const;
+
+    private:
+        void* address;
+        size_t length;
+    };
+
+/*
+=================================IMPLEMENTATION=================================
+*/
+
+    MappedFile::MappedFile() : address(nullptr), length(0) {}
+
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+    bool MappedFile::open(const std::string& filename) {
+        close();
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+        void* mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED)
+            return false;
+        address = mapped;
+        length = static_cast<size_t>(info.st_size);
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (address)
+            munmap(address, length);
+        address = nullptr;
+        length = 0;
+    }
+
+    const void* MappedFile::data() const {
+        return address;
+    }
+
+    size_t MappedFile::size() const {
+        return length;
+    }
+}
@@ -0,0 +1,302 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <ostream>
+#include <cstddef>
+
+namespace SALIB {
+    // Containers whose allocations are counted
+    enum class MemoryCategory {
+        POLYNOMIAL_NODES,   // Map nodes of Polynomial
+        MONOMIAL_VECTORS,   // Exponent vectors of Monomial
+        PAIR_QUEUE,         // Heap, pending set and discarded pairs of PairQueue
+        COUNT
+    };
+
+    // Part of a computation an allocation is attributed to, set per thread by MemoryPhaseScope
+    enum class MemoryPhase {
+        OTHER,
+        INPUT_CONVERSION,
+        PAIR_PROCESSING,
+        REDUCTION,
+        INTERREDUCTION,
+        COUNT
+    };
+
+    inline const char* to_string(MemoryCategory category);
+    inline const char* to_string(MemoryPhase phase);
+
+    struct CategoryMemoryUsage {
+        size_t allocations;
+        size_t allocated_bytes;
+        size_t current_bytes;
+        size_t peak_bytes;
+    };
+
+    struct PhaseMemoryUsage {
+        size_t allocations;
+        size_t allocated_bytes;
+        size_t peak_bytes;      // Largest total of all categories while the phase was active
+    };
+
+    // Process wide counters of the allocations made through AccountedAllocator. They are only filled in
+    // builds with SALIB_MEMORY_ACCOUNTING, otherwise the containers use std::allocator and nothing is counted
+    class MemoryAccounting {
+    public:
+        inline static constexpr bool is_enabled();
+
+        inline static CategoryMemoryUsage get_usage(MemoryCategory category);
+        inline static PhaseMemoryUsage get_usage(MemoryPhase phase);
+        inline static size_t get_current_bytes();
+        inline static size_t get_peak_bytes();
+        // Clears the allocation counts, the peaks restart from the current usage
+        inline static void reset();
+
+        // One JSON object with the categories, the phases and the totals
+        inline static void write_json(std::ostream& out);
+
+        inline static MemoryPhase get_phase();
+        inline static void set_phase(MemoryPhase phase);
+
+        inline static void on_allocate(MemoryCategory category, size_t bytes);
+        inline static void on_deallocate(MemoryCategory category, size_t bytes);
+
+    private:
+        struct Counters {
+            std::atomic<size_t> allocations{0};
+            std::atomic<size_t> allocated_bytes{0};
+            std::atomic<size_t> current_bytes{0};
+            std::atomic<size_t> peak_bytes{0};
+        };
+
+        struct State {
+            Counters categories[static_cast<size_t>(MemoryCategory::COUNT)];
+            Counters phases[static_cast<size_t>(MemoryPhase::COUNT)];
+            std::atomic<size_t> current_bytes{0};
+            std::atomic<size_t> peak_bytes{0};
+        };
+
+        inline static State& get_state();
+        inline static MemoryPhase& get_thread_phase();
+        inline static void update_peak(std::atomic<size_t>& peak, size_t value);
+    };
+
+    // Sets the phase of the current thread for its scope, scopes nest
+    class MemoryPhaseScope {
+    public:
+        inline explicit MemoryPhaseScope(MemoryPhase phase);
+        inline ~MemoryPhaseScope();
+
+        MemoryPhaseScope(const MemoryPhaseScope&) = delete;
+        MemoryPhaseScope& operator=(const MemoryPhaseScope&) = delete;
+
+    private:
+        MemoryPhase previous;
+    };
+
+    // std::allocator that reports every block to MemoryAccounting
+    template <typename T, MemoryCategory Category>
+    class CountingAllocator {
+    public:
+        using value_type = T;
+
+        template <typename Other>
+        struct rebind {
+            using other = CountingAllocator<Other, Category>;
+        };
+
+        CountingAllocator() = default;
+        template <typename Other>
+        CountingAllocator(const CountingAllocator<Other, Category>&) {}
+
+        inline T* allocate(size_t count);
+        inline void deallocate(T* pointer, size_t count);
+
+        template <typename Other>
+        bool operator==(const CountingAllocator<Other, Category>&) const {
+            return true;
+        }
+
+        template <typename Other>
+        bool operator!=(const CountingAllocator<Other, Category>&) const {
+            return false;
+        }
+    };
+
+#ifdef SALIB_MEMORY_ACCOUNTING
+    template <typename T, MemoryCategory Category>
+    using AccountedAllocator = CountingAllocator<T, Category>;
+#else
+    template <typename T, MemoryCategory Category>
+    using AccountedAllocator = std::allocator<T>;
+#endif
+
+/*
+=================================IMPLEMENTATION=================================
+*/
+
+    const char* to_string(MemoryCategory category) {
+        switch (category) {
+            case MemoryCategory::POLYNOMIAL_NODES:
+                return "polynomial_nodes";
+            case MemoryCategory::MONOMIAL_VECTORS:
+                return "monomial_vectors";
+            case MemoryCategory::PAIR_QUEUE:
+                return "pair_queue";
+            case MemoryCategory::COUNT:
+                break;
+        }
+        return "unknown";
+    }
+
+    const char* to_string(MemoryPhase phase) {
+        switch (phase) {
+            case MemoryPhase::OTHER:
+                return "other";
+            case MemoryPhase::INPUT_CONVERSION:
+                return "input_conversion";
+            case MemoryPhase::PAIR_PROCESSING:
+                return "pair_processing";
+            case MemoryPhase::REDUCTION:
+                return "reduction";
+            case MemoryPhase::INTERREDUCTION:
+                return "interreduction";
+            case MemoryPhase::COUNT:
+                break;
+        }
+        return "unknown";
+    }
+
+    constexpr bool MemoryAccounting::is_enabled() {
+#ifdef SALIB_MEMORY_ACCOUNTING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    MemoryAccounting::State& MemoryAccounting::get_state() {
+        // Never destroyed, containers of static objects are freed after the end of main
+        static State* state = new State();
+        return *state;
+    }
+
+    void MemoryAccounting::update_peak(std::atomic<size_t>& peak, size_t value) {
+        size_t current_peak = peak.load(std::memory_order_relaxed);
+        while (value > current_peak && !peak.compare_exchange_weak(current_peak, value, std::memory_order_relaxed)) {}
+    }
+
+    CategoryMemoryUsage MemoryAccounting::get_usage(MemoryCategory category) {
+        const Counters& counters = get_state().categories[static_cast<size_t>(category)];
+        return CategoryMemoryUsage{counters.allocations.load(), counters.allocated_bytes.load(),
+                                   counters.current_bytes.load(), counters.peak_bytes.load()};
+    }
+
+    PhaseMemoryUsage MemoryAccounting::get_usage(MemoryPhase phase) {
+        const Counters& counters = get_state().phases[static_cast<size_t>(phase)];
+        return PhaseMemoryUsage{counters.allocations.load(), counters.allocated_bytes.load(),
+                                counters.peak_bytes.load()};
+    }
+
+    size_t MemoryAccounting::get_current_bytes() {
+        return get_state().current_bytes.load();
+    }
+
+    size_t MemoryAccounting::get_peak_bytes() {
+        return get_state().peak_bytes.load();
+    }
+
+    void MemoryAccounting::reset() {
+        State& state = get_state();
+        for (auto& counters : state.categories) {
+            counters.allocations = 0;
+            counters.allocated_bytes = 0;
+            counters.peak_bytes = counters.current_bytes.load();
+        }
+        for (auto& counters : state.phases) {
+            counters.allocations = 0;
+            counters.allocated_bytes = 0;
+            counters.peak_bytes = 0;
+        }
+        state.peak_bytes = state.current_bytes.load();
+    }
+
+    void MemoryAccounting::write_json(std::ostream& out) {
+        out << "{\"enabled\": " << (is_enabled() ? "true" : "false")
+            << ", \"current_bytes\": " << get_current_bytes() << ", \"peak_bytes\": " << get_peak_bytes()
+            << ", \"categories\": {";
+        for (size_t idx = 0; idx < static_cast<size_t>(MemoryCategory::COUNT); ++idx) {
+            CategoryMemoryUsage usage = get_usage(static_cast<MemoryCategory>(idx));
+            out << (idx ? ", \"" : "\"") << to_string(static_cast<MemoryCategory>(idx))
+                << "\": {\"allocations\": " << usage.allocations << ", \"allocated_bytes\": " << usage.allocated_bytes
+                << ", \"current_bytes\": " << usage.current_bytes << ", \"peak_bytes\": " << usage.peak_bytes << "}";
+        }
+        out << "}, \"phases\": {";
+        for (size_t idx = 0; idx < static_cast<size_t>(MemoryPhase::COUNT); ++idx) {
+            PhaseMemoryUsage usage = get_usage(static_cast<MemoryPhase>(idx));
+            out << (idx ? ", \"" : "\"") << to_string(static_cast<MemoryPhase>(idx))
+                << "\": {\"allocations\": " << usage.allocations << ", \"allocated_bytes\": " << usage.allocated_bytes
+                << ", \"peak_bytes\": " << usage.peak_bytes << "}";
+        }
+        out << "}}";
+    }
+
+    MemoryPhase& MemoryAccounting::get_thread_phase() {
+        thread_local MemoryPhase phase = MemoryPhase::OTHER;
+        return phase;
+    }
+
+    MemoryPhase MemoryAccounting::get_phase() {
+        return get_thread_phase();
+    }
+
+    void MemoryAccounting::set_phase(MemoryPhase phase) {
+        get_thread_phase() = phase;
+    }
+
+    void MemoryAccounting::on_allocate(MemoryCategory category, size_t bytes) {
+        State& state = get_state();
+        Counters& counters = state.categories[static_cast<size_t>(category)];
+        counters.allocations.fetch_add(1, std::memory_order_relaxed);
+        counters.allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+        update_peak(counters.peak_bytes, counters.current_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+
+        size_t total = state.current_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        update_peak(state.peak_bytes, total);
+        Counters& phase = state.phases[static_cast<size_t>(get_thread_phase())];
+        phase.allocations.fetch_add(1, std::memory_order_relaxed);
+        phase.allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+        update_peak(phase.peak_bytes, total);
+    }
+
+    void MemoryAccounting::on_deallocate(MemoryCategory category, size_t bytes) {
+        State& state = get_state();
+        state.categories[static_cast<size_t>(category)].current_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+        state.current_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    MemoryPhaseScope::MemoryPhaseScope(MemoryPhase phase) : previous(MemoryPhase::OTHER) {
+        if (!MemoryAccounting::is_enabled())
+            return;
+        previous = MemoryAccounting::get_phase();
+        MemoryAccounting::set_phase(phase);
+    }
+
+    MemoryPhaseScope::~MemoryPhaseScope() {
+        if (MemoryAccounting::is_enabled())
+            MemoryAccounting::set_phase(previous);
+    }
+
+    template <typename T, MemoryCategory Category>
+    T* CountingAllocator<T, Category>::allocate(size_t count) {
+        T* res = std::allocator<T>().allocate(count);
+        MemoryAccounting::on_allocate(Category, count * sizeof(T));
+        return res;
+    }
+
+    template <typename T, MemoryCategory Category>
+    void CountingAllocator<T, Category>::deallocate(T* pointer, size_t count) {
+        MemoryAccounting::on_deallocate(Category, count * sizeof(T));
+        std::allocator<T>().deallocate(pointer, count);
+    }
+}
@@ -0,0 +1,299 @@
+#pragma once
+#include "field.h"
+#include "sparse_matrix.h"
+#include "thread_pool.h"
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <utility>
+
+namespace SALIB {
+    struct EliminationStatistics {
+        size_t pivot_rows = 0;      // Rows with a new leading column, taken as they are
+        size_t reduced_rows = 0;    // Rows reduced by the pivot rows in the sparse phase
+        size_t dense_rows = 0;      // Rows left for the dense phase
+        size_t dense_columns = 0;
+        size_t rank = 0;
+    };
+
+    // Structured Gaussian elimination over GF(P), P < 2^31:
+    //  1. every leading column gets its sparsest row as a pivot row, no arithmetic is needed for them;
+    //  2. the remaining rows are reduced by the pivot rows, blocks of rows run on the thread pool;
+    //  3. what is left lives in the columns without pivots and is usually small and dense,
+    //     it is eliminated with contiguous 32x32->64 bit multiply-add loops the compiler vectorizes.
+    // Additions are accumulated in 64 bits and reduced modulo P only when needed.
+    template <int P>
+    class ModularElimination {
+    public:
+        using CoefficientType = Field<P>;
+        using Matrix = SparseMatrix<CoefficientType>;
+
+        // Same row space, rank and pivot columns as Matrix::row_echelon_form with monic pivots and rows
+        // ordered by pivot column. The entries right of the pivots may differ between the two
+        inline static EliminationStatistics row_echelon_form(Matrix& matrix, size_t threads_count = 1);
+
+    private:
+        using Value = uint32_t;
+        using Accumulator = uint64_t;
+
+        struct PivotRow {
+            std::vector<size_t> columns;
+            std::vector<Value> values;
+        };
+
+        using SparseRow = std::vector<std::pair<size_t, Value>>;
+
+        // Products are below (P - 1)^2, so this many of them fit into an accumulator
+        static const Accumulator MAX_LAZY_ADDITIONS =
+            (std::numeric_limits<Accumulator>::max() - P) / (Accumulator(P - 1) * Accumulator(P - 1) + 1);
+
+        inline static Value inverse(Value value);
+
+        inline static PivotRow make_pivot_row(const typename Matrix::Row& row);
+
+        inline static void reduce_by_pivots(
+            const typename Matrix::Row& row,
+            const std::vector<PivotRow>& pivots,
+            const std::vector<size_t>& pivot_of_column,
+            std::vector<Accumulator>& dense,
+            SparseRow& rest
+        );
+
+        inline static std::vector<SparseRow> dense_echelon_form(
+            const std::vector<SparseRow>& rows,
+            size_t& dense_columns
+        );
+
+        static const size_t NO_PIVOT = std::numeric_limits<size_t>::max();
+    };
+
+    // Uses the modular engine for prime field matrices and the generic elimination otherwise
+    template <typename CoefficientType>
+    inline void row_echelon_form(SparseMatrix<CoefficientType>& matrix, size_t threads_count = 1);
+
+    template <int P>
+    inline void row_echelon_form(SparseMatrix<Field<P>>& matrix, size_t threads_count = 1);
+
+/*
+=================================IMPLEMENTATION=================================
+*/
+
+    template <int P>
+    const typename ModularElimination<P>::Accumulator ModularElimination<P>::MAX_LAZY_ADDITIONS;
+
+    template <int P>
+    const size_t ModularElimination<P>::NO_PIVOT;
+
+    template <int P>
+    typename ModularElimination<P>::Value ModularElimination<P>::inverse(Value value) {
+        return static_cast<Value>(CoefficientType::inverse(value));
+    }
+
+    template <int P>
+    typename ModularElimination<P>::PivotRow ModularElimination<P>::make_pivot_row(const typename Matrix::Row& row) {
+        PivotRow pivot;
+        pivot.columns.reserve(row.size());
+        pivot.values.reserve(row.size());
+        Accumulator lead_inverse = inverse(static_cast<Value>(row.front().second.n));
+        for (const auto& entry : row) {
+            pivot.columns.push_back(entry.first);
+            pivot.values.push_back(static_cast<Value>(entry.second.n * lead_inverse % P));
+        }
+        return pivot;
+    }
+
+    template <int P>
+    void ModularElimination<P>::reduce_by_pivots(
+            const typename Matrix::Row& row,
+            const std::vector<PivotRow>& pivots,
+            const std::vector<size_t>& pivot_of_column,
+            std::vector<Accumulator>& dense,
+            SparseRow& rest) {
+        rest.clear();
+        for (const auto& entry : row)
+            dense[entry.first] = entry.second.n;
+        Accumulator additions = 0;
+        for (size_t col = row.front().first; col < dense.size(); ++col) {
+            if (dense[col] == 0)
+                continue;
+            Value value = static_cast<Value>(dense[col] % P);
+            dense[col] = 0;
+            if (value == 0)
+                continue;
+            if (pivot_of_column[col] == NO_PIVOT) {
+                rest.emplace_back(col, value);
+                continue;
+            }
+            if (++additions == MAX_LAZY_ADDITIONS) {
+                for (size_t idx = col + 1; idx < dense.size(); ++idx)
+                    dense[idx] %= P;
+                additions = 1;
+            }
+            const PivotRow& pivot = pivots[pivot_of_column[col]];
+            Accumulator factor = P - value;
+            for (size_t idx = 1; idx < pivot.columns.size(); ++idx)
+                dense[pivot.columns[idx]] += factor * pivot.values[idx];
+        }
+    }
+
+    template <int P>
+    std::vector<typename ModularElimination<P>::SparseRow>
+    ModularElimination<P>::dense_echelon_form(const std::vector<SparseRow>& rows, size_t& dense_columns) {
+        std::vector<size_t> columns;
+        for (const auto& row : rows) {
+            for (const auto& entry : row)
+                columns.push_back(entry.first);
+        }
+        std::sort(columns.begin(), columns.end());
+        columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+        const size_t width = columns.size();
+        dense_columns = width;
+
+        std::vector<std::vector<Value>> pivots;
+        std::vector<size_t> pivot_of_column(width, NO_PIVOT);
+        std::vector<Accumulator> dense(width);
+        for (const auto& row : rows) {
+            std::fill(dense.begin(), dense.end(), 0);
+            for (const auto& entry : row)
+                dense[std::lower_bound(columns.begin(), columns.end(), entry.first) - columns.begin()] = entry.second;
+
+            Accumulator additions = 0;
+            for (size_t col = 0; col < width; ++col) {
+                Value value = static_cast<Value>(dense[col] % P);
+                if (value == 0)
+                    continue;
+                if (pivot_of_column[col] == NO_PIVOT) {
+                    // New pivot: the row is brought to canonical residues and made monic
+                    Accumulator lead_inverse = inverse(value);
+                    std::vector<Value> pivot(width, 0);
+                    for (size_t idx = col; idx < width; ++idx)
+                        pivot[idx] = static_cast<Value>(dense[idx] % P * lead_inverse % P);
+                    pivot_of_column[col] = pivots.size();
+                    pivots.push_back(std::move(pivot));
+                    break;
+                }
+                if (++additions == MAX_LAZY_ADDITIONS) {
+                    for (size_t idx = col; idx < width; ++idx)
+                        dense[idx] %= P;
+                    additions = 1;
+                }
+                const Value factor = P - value;
+                const Value* pivot = pivots[pivot_of_column[col]].data();
+                Accumulator* target = dense.data();
+                for (size_t idx = col; idx < width; ++idx)
+                    target[idx] += Accumulator(factor) * pivot[idx];
+            }
+        }
+
+        std::vector<SparseRow> result;
+        for (size_t col = 0; col < width; ++col) {
+            if (pivot_of_column[col] == NO_PIVOT)
+                continue;
+            const std::vector<Value>& pivot = pivots[pivot_of_column[col]];
+            SparseRow row;
+            for (size_t idx = col; idx < width; ++idx) {
+                if (pivot[idx] != 0)
+                    row.emplace_back(columns[idx], pivot[idx]);
+            }
+            result.push_back(std::move(row));
+        }
+        return result;
+    }
+
+    template <int P>
+    EliminationStatistics ModularElimination<P>::row_echelon_form(Matrix& matrix, size_t threads_count) {
+        EliminationStatistics statistics;
+        const size_t columns = matrix.columns_count();
+        if (threads_count == 0)
+            threads_count = 1;
+
+        // Pivot detection: the sparsest row for every leading column
+        std::vector<size_t> pivot_source(columns, NO_PIVOT);
+        for (size_t idx = 0; idx < matrix.rows_count(); ++idx) {
+            size_t lead = matrix[idx].front().first;
+            if (pivot_source[lead] == NO_PIVOT || matrix[idx].size() < matrix[pivot_source[lead]].size())
+                pivot_source[lead] = idx;
+        }
+        std::vector<PivotRow> pivots;
+        std::vector<size_t> pivot_of_column(columns, NO_PIVOT);
+        std::vector<bool> is_pivot_row(matrix.rows_count(), false);
+        for (size_t col = 0; col < columns; ++col) {
+            if (pivot_source[col] == NO_PIVOT)
+                continue;
+            is_pivot_row[pivot_source[col]] = true;
+            pivot_of_column[col] = pivots.size();
+            pivots.push_back(make_pivot_row(matrix[pivot_source[col]]));
+        }
+        std::vector<size_t> to_reduce;
+        for (size_t idx = 0; idx < matrix.rows_count(); ++idx) {
+            if (!is_pivot_row[idx])
+                to_reduce.push_back(idx);
+        }
+        statistics.pivot_rows = pivots.size();
+        statistics.reduced_rows = to_reduce.size();
+
+        // Sparse phase: rows are independent, every block has its own accumulator
+        std::vector<SparseRow> rests(to_reduce.size());
+        const size_t block_size = std::max<size_t>(1, to_reduce.size() / (4 * threads_count));
+        auto reduce_block = [&matrix, &pivots, &pivot_of_column, &to_reduce, &rests, columns](size_t begin, size_t end) {
+            std::vector<Accumulator> dense(columns, 0);
+            for (size_t idx = begin; idx < end; ++idx)
+                reduce_by_pivots(matrix[to_reduce[idx]], pivots, pivot_of_column, dense, rests[idx]);
+        };
+        if (threads_count == 1) {
+            reduce_block(0, to_reduce.size());
+        } else {
+            ThreadPool pool(threads_count);
+            for (size_t begin = 0; begin < to_reduce.size(); begin += block_size) {
+                size_t end = std::min(to_reduce.size(), begin + block_size);
+                pool.submit([&reduce_block, begin, end] { reduce_block(begin, end); });
+            }
+            pool.wait();
+        }
+        rests.erase(std::remove_if(rests.begin(), rests.end(), [](const SparseRow& row) {
+            return row.empty();
+        }), rests.end());
+        statistics.dense_rows = rests.size();
+
+        // Dense phase on the columns without pivots
+        std::vector<SparseRow> new_pivots = dense_echelon_form(rests, statistics.dense_columns);
+
+        std::vector<typename Matrix::Row> result(columns);
+        for (size_t col = 0; col < columns; ++col) {
+            if (pivot_of_column[col] == NO_PIVOT)
+                continue;
+            const PivotRow& pivot = pivots[pivot_of_column[col]];
+            typename Matrix::Row& row = result[col];
+            row.reserve(pivot.columns.size());
+            for (size_t idx = 0; idx < pivot.columns.size(); ++idx)
+                row.emplace_back(pivot.columns[idx], CoefficientType(pivot.values[idx]));
+        }
+        for (const auto& new_pivot : new_pivots) {
+            typename Matrix::Row& row = result[new_pivot.front().first];
+            row.reserve(new_pivot.size());
+            for (const auto& entry : new_pivot)
+                row.emplace_back(entry.first, CoefficientType(entry.second));
+        }
+
+        Matrix echelon(columns);
+        for (auto& row : result) {
+            if (!row.empty()) {
+                echelon.add_row(std::move(row));
+                ++statistics.rank;
+            }
+        }
+        matrix = std::move(echelon);
+        return statistics;
+    }
+
+    template <typename CoefficientType>
+    void row_echelon_form(SparseMatrix<CoefficientType>& matrix, size_t) {
+        matrix.row_echelon_form();
+    }
+
+    template <int P>
+    void row_echelon_form(SparseMatrix<Field<P>>& matrix, size_t threads_count) {
+        ModularElimination<P>::row_echelon_form(matrix, threads_count);
+    }
+}
@@ -3,6 +3,7 @@
 #include <vector>
 #include <algorithm>
 #include "orders.h"
+#include "memory_accounting.h"
 
 namespace SALIB {
 
@@ -10,7 +11,8 @@ namespace SALIB {
     public:
         using VariableIndexType = size_t;
         using VariableDegreeType = unsigned long long;
-        using VariablesContainer = std::vector<VariableDegreeType>;
+        using VariablesContainer = std::vector<VariableDegreeType,
+                                               AccountedAllocator<VariableDegreeType, MemoryCategory::MONOMIAL_VECTORS>>;
         using iterator = VariablesContainer::iterator;
         using const_iterator = VariablesContainer::const_iterator;
         using reverse_iterator = VariablesContainer::reverse_iterator;
@@ -86,8 +88,10 @@ namespace SALIB {
     Monomial Monomial::lcm(const Monomial& a, const Monomial& b) {
         Monomial res(a);
         for (size_t i = 0; i < b.variables.size(); ++i) {
-            res[i] = std::max(res[i], b[i]);
-            res.degree += std::max(res[i], b[i]) - res[i];
+            if (res[i] < b[i]) {
+                res.degree += b[i] - res[i];
+                res[i] = b[i];
+            }
         }
         return res;
     }
@@ -140,8 +144,8 @@ namespace SALIB {
     }
 
     Monomial::VariableDegreeType& Monomial::operator[](VariableIndexType var_index) {
-        while (variables.size() <= var_index)
-            variables.push_back(0);
+        if (variables.size() <= var_index)
+            variables.resize(var_index + 1, 0);
         return variables[var_index];
     }
 
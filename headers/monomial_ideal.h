@@ -0,0 +1,340 @@
+#pragma once
+#include "monomial.h"
+#include <vector>
+#include <algorithm>
+#include <utility>
+
+namespace SALIB {
+    // Ideal generated by monomials, e.g. the leading monomials of a Groebner basis.
+    // All invariants are those of the quotient ring k[x_0, ..., x_{n - 1}] / I
+    class MonomialIdeal {
+    public:
+        using DegreeType = Monomial::VariableDegreeType;
+        using Series = std::vector<long long>;  // Coefficient of t^i at index i
+
+        // variables_count = 0 means the smallest ring containing every generator
+        inline explicit MonomialIdeal(const std::vector<Monomial>& generators, size_t variables_count = 0);
+
+        template <typename PolyContainer>
+        inline static MonomialIdeal from_leading_monomials(const PolyContainer& basis, size_t variables_count = 0);
+
+        inline const std::vector<Monomial>& get_minimal_generators() const;
+        inline size_t get_variables_count() const;
+
+        inline bool contains(const Monomial& mono) const;
+
+        // Every variable has a pure power among the generators
+        inline bool is_zero_dimensional() const;
+
+        // Numerator K(t) of the Hilbert series K(t) / (1 - t)^n
+        inline Series get_hilbert_numerator() const;
+        // Numerator after cancelling (1 - t)^(n - dimension)
+        inline Series get_reduced_hilbert_numerator() const;
+
+        // The unit ideal has dimension 0 and degree 0
+        inline size_t get_dimension() const;
+        // Multiplicity, the number of standard monomials for a zero-dimensional ideal
+        inline long long get_degree() const;
+
+    private:
+        using Exponents = std::vector<DegreeType>;
+
+        inline static void minimize(std::vector<Exponents>& generators);
+        inline static bool divides(const Exponents& a, const Exponents& b);
+        inline static DegreeType total_degree(const Exponents& mono);
+        inline static unsigned long long support_mask(const Exponents& mono);
+        inline static Series multiply(const Series& a, const Series& b);
+        inline static Series hilbert_numerator(std::vector<Exponents> generators, size_t variables_count,
+                                               bool is_minimal);
+        inline static void add_shifted(Series& res, const Series& other, DegreeType shift);
+        // Divides by (1 - t) while t = 1 is a root, returns the number of divisions
+        inline static size_t cancel_denominator(Series& numerator);
+
+        std::vector<Exponents> exponents;
+        std::vector<Monomial> generators;
+        size_t variables_count;
+        Series numerator;
+    };
+
+/*
+=================================IMPLEMENTATION=================================
+*/
+
+    MonomialIdeal::MonomialIdeal(const std::vector<Monomial>& monomials, size_t variables_count)
+            : variables_count(variables_count) {
+        for (const auto& mono : monomials) {
+            size_t used = 0;
+            for (size_t var = 0; var < static_cast<size_t>(mono.end() - mono.begin()); ++var) {
+                if (mono[var] != 0)
+                    used = var + 1;
+            }
+            this->variables_count = std::max(this->variables_count, used);
+        }
+        for (const auto& mono : monomials) {
+            Exponents exps(this->variables_count, 0);
+            for (size_t var = 0; var < this->variables_count; ++var)
+                exps[var] = mono[var];
+            exponents.push_back(std::move(exps));
+        }
+        minimize(exponents);
+        for (const auto& exps : exponents) {
+            Monomial mono;
+            for (size_t var = 0; var < exps.size(); ++var) {
+                if (exps[var] != 0)
+                    mono *= Monomial(var, exps[var]);
+            }
+            generators.push_back(std::move(mono));
+        }
+        numerator = hilbert_numerator(exponents, this->variables_count, true);
+    }
+
+    template <typename PolyContainer>
+    MonomialIdeal MonomialIdeal::from_leading_monomials(const PolyContainer& basis, size_t variables_count) {
+        std::vector<Monomial> monomials;
+        for (const auto& poly : basis) {
+            if (!poly.is_zero())
+                monomials.push_back(poly.get_largest_monomial());
+        }
+        return MonomialIdeal(monomials, variables_count);
+    }
+
+    const std::vector<Monomial>& MonomialIdeal::get_minimal_generators() const {
+        return generators;
+    }
+
+    size_t MonomialIdeal::get_variables_count() const {
+        return variables_count;
+    }
+
+    bool MonomialIdeal::divides(const Exponents& a, const Exponents& b) {
+        for (size_t var = 0; var < a.size(); ++var) {
+            if (a[var] > b[var])
+                return false;
+        }
+        return true;
+    }
+
+    MonomialIdeal::DegreeType MonomialIdeal::total_degree(const Exponents& mono) {
+        DegreeType degree = 0;
+        for (auto exp : mono)
+            degree += exp;
+        return degree;
+    }
+
+    unsigned long long MonomialIdeal::support_mask(const Exponents& mono) {
+        unsigned long long mask = 0;
+        for (size_t var = 0; var < mono.size(); ++var) {
+            if (mono[var] != 0)
+                mask |= 1ULL << (var % 64);
+        }
+        return mask;
+    }
+
+    void MonomialIdeal::minimize(std::vector<Exponents>& monomials) {
+        // A divisor has smaller degree, so it is kept before anything it divides is seen
+        std::vector<std::pair<DegreeType, size_t>> by_degree;
+        by_degree.reserve(monomials.size());
+        for (size_t idx = 0; idx < monomials.size(); ++idx)
+            by_degree.emplace_back(total_degree(monomials[idx]), idx);
+        std::sort(by_degree.begin(), by_degree.end());
+
+        std::vector<Exponents> minimal;
+        std::vector<unsigned long long> masks;
+        for (const auto& it : by_degree) {
+            Exponents& mono = monomials[it.second];
+            unsigned long long mask = support_mask(mono);
+            bool redundant = false;
+            for (size_t idx = 0; idx < minimal.size() && !redundant; ++idx)
+                redundant = (masks[idx] & ~mask) == 0 && divides(minimal[idx], mono);
+            if (!redundant) {
+                minimal.push_back(std::move(mono));
+                masks.push_back(mask);
+            }
+        }
+        monomials = std::move(minimal);
+    }
+
+    bool MonomialIdeal::contains(const Monomial& mono) const {
+        for (const auto& gen : generators) {
+            if (mono.is_dividable_by(gen))
+                return true;
+        }
+        return false;
+    }
+
+    bool MonomialIdeal::is_zero_dimensional() const {
+        std::vector<bool> has_pure_power(variables_count, false);
+        for (const auto& exps : exponents) {
+            size_t used = 0, var_index = 0;
+            for (size_t var = 0; var < exps.size(); ++var) {
+                if (exps[var] != 0) {
+                    ++used;
+                    var_index = var;
+                }
+            }
+            if (used == 1)
+                has_pure_power[var_index] = true;
+            if (used == 0)
+                return true;  // The unit ideal
+        }
+        return std::find(has_pure_power.begin(), has_pure_power.end(), false) == has_pure_power.end();
+    }
+
+    void MonomialIdeal::add_shifted(Series& res, const Series& other, DegreeType shift) {
+        if (res.size() < other.size() + shift)
+            res.resize(other.size() + shift, 0);
+        for (size_t idx = 0; idx < other.size(); ++idx)
+            res[idx + shift] += other[idx];
+    }
+
+    MonomialIdeal::Series MonomialIdeal::multiply(const Series& a, const Series& b) {
+        Series product(a.size() + b.size() - 1, 0);
+        for (size_t i = 0; i < a.size(); ++i) {
+            for (size_t j = 0; j < b.size(); ++j)
+                product[i + j] += a[i] * b[j];
+        }
+        return product;
+    }
+
+    MonomialIdeal::Series MonomialIdeal::hilbert_numerator(
+            std::vector<Exponents> monomials,
+            size_t variables_count,
+            bool is_minimal) {
+        if (!is_minimal)
+            minimize(monomials);
+        std::vector<size_t> occurrences(variables_count, 0);
+        for (const auto& mono : monomials) {
+            for (size_t var = 0; var < variables_count; ++var)
+                occurrences[var] += mono[var] != 0;
+        }
+        size_t pivot_var = std::max_element(occurrences.begin(), occurrences.end()) - occurrences.begin();
+
+        // Pairwise coprime generators: K(t) is the product of (1 - t^deg)
+        if (variables_count == 0 || occurrences[pivot_var] <= 1) {
+            Series res = {1};
+            for (const auto& mono : monomials) {
+                Series factor(total_degree(mono) + 1, 0);
+                factor[0] = 1;
+                factor.back() -= 1;
+                res = multiply(res, factor);
+            }
+            return res;
+        }
+
+        // Generators sharing no variables split the numerator into a product
+        std::vector<size_t> component(variables_count);
+        for (size_t var = 0; var < variables_count; ++var)
+            component[var] = var;
+        auto find = [&component](size_t var) {
+            while (component[var] != var)
+                var = component[var] = component[component[var]];
+            return var;
+        };
+        for (const auto& mono : monomials) {
+            size_t first_var = variables_count;
+            for (size_t var = 0; var < variables_count; ++var) {
+                if (mono[var] == 0)
+                    continue;
+                if (first_var == variables_count)
+                    first_var = var;
+                else
+                    component[find(var)] = find(first_var);
+            }
+        }
+        std::vector<std::vector<Exponents>> parts;
+        std::vector<size_t> part_of_root(variables_count, monomials.size());
+        for (auto& mono : monomials) {
+            size_t root = find(std::find_if(mono.begin(), mono.end(), [](DegreeType exp) { return exp != 0; }) - mono.begin());
+            if (part_of_root[root] == monomials.size()) {
+                part_of_root[root] = parts.size();
+                parts.emplace_back();
+            }
+            parts[part_of_root[root]].push_back(std::move(mono));
+        }
+        if (parts.size() > 1) {
+            Series res = {1};
+            for (auto& part : parts)
+                res = multiply(res, hilbert_numerator(std::move(part), variables_count, true));
+            return res;
+        }
+        monomials = std::move(parts.front());
+
+        // Pivot p = x^e with the lower median exponent: K(I) = K(I + (p)) + t^e K(I : p)
+        std::vector<DegreeType> pivot_exps;
+        for (const auto& mono : monomials) {
+            if (mono[pivot_var] != 0)
+                pivot_exps.push_back(mono[pivot_var]);
+        }
+        auto median = pivot_exps.begin() + (pivot_exps.size() - 1) / 2;
+        std::nth_element(pivot_exps.begin(), median, pivot_exps.end());
+        DegreeType pivot_exp = *median;
+
+        // Generators of I + (p) stay minimal, p itself is dropped if a smaller power of x is present
+        std::vector<Exponents> sum, quotient;
+        bool pivot_is_redundant = false;
+        for (auto& mono : monomials) {
+            if (mono[pivot_var] < pivot_exp) {
+                if (mono[pivot_var] != 0 && total_degree(mono) == mono[pivot_var])
+                    pivot_is_redundant = true;
+                sum.push_back(mono);
+            }
+            mono[pivot_var] -= std::min(mono[pivot_var], pivot_exp);
+            quotient.push_back(std::move(mono));
+        }
+        if (!pivot_is_redundant) {
+            Exponents pivot(variables_count, 0);
+            pivot[pivot_var] = pivot_exp;
+            sum.push_back(std::move(pivot));
+        }
+
+        Series res = hilbert_numerator(std::move(sum), variables_count, true);
+        add_shifted(res, hilbert_numerator(std::move(quotient), variables_count, false), pivot_exp);
+        while (res.size() > 1 && res.back() == 0)
+            res.pop_back();
+        return res;
+    }
+
+    MonomialIdeal::Series MonomialIdeal::get_hilbert_numerator() const {
+        return numerator;
+    }
+
+    size_t MonomialIdeal::cancel_denominator(Series& numerator) {
+        size_t divisions = 0;
+        while (numerator.size() > 1) {
+            long long value_at_one = 0;
+            for (auto coef : numerator)
+                value_at_one += coef;
+            if (value_at_one != 0)
+                break;
+            Series quotient(numerator.size() - 1, 0);
+            long long partial = 0;
+            for (size_t idx = 0; idx + 1 < numerator.size(); ++idx) {
+                partial += numerator[idx];
+                quotient[idx] = partial;
+            }
+            numerator = std::move(quotient);
+            ++divisions;
+        }
+        return divisions;
+    }
+
+    MonomialIdeal::Series MonomialIdeal::get_reduced_hilbert_numerator() const {
+        Series res = get_hilbert_numerator();
+        cancel_denominator(res);
+        return res;
+    }
+
+    size_t MonomialIdeal::get_dimension() const {
+        Series numerator = get_hilbert_numerator();
+        if (numerator.size() == 1 && numerator[0] == 0)
+            return 0;
+        return variables_count - cancel_denominator(numerator);
+    }
+
+    long long MonomialIdeal::get_degree() const {
+        long long degree = 0;
+        for (auto coef : get_reduced_hilbert_numerator())
+            degree += coef;
+        return degree;
+    }
+}
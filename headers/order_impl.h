@@ -17,6 +17,36 @@ namespace SALIB {
     }
 
 
+    template<size_t Count>
+    int PrefixLexSemiOrder<Count>::cmp(const Monomial &a, const Monomial &b) {
+        for (size_t var = 0; var < Count; ++var) {
+            if (a[var] != b[var])
+                return a[var] < b[var] ? -1 : 1;
+        }
+        return 0;
+    }
+
+    template<size_t Count>
+    bool PrefixLexSemiOrder<Count>::operator()(const Monomial &a, const Monomial &b) const {
+        return PrefixLexSemiOrder<Count>::cmp(a, b) < 0;
+    }
+
+
+    template<typename Order>
+    int HomogenizedOrder<Order>::cmp(const Monomial &a, const Monomial &b) {
+        if (a.get_degree() != b.get_degree())
+            return a.get_degree() < b.get_degree() ? -1 : 1;
+        if (a[0] != b[0])
+            return a[0] > b[0] ? -1 : 1;
+        return Order::cmp(a, b);
+    }
+
+    template<typename Order>
+    bool HomogenizedOrder<Order>::operator()(const Monomial &a, const Monomial &b) const {
+        return HomogenizedOrder<Order>::cmp(a, b) < 0;
+    }
+
+
     template<typename FirstOrder, typename ... Orders>
     int CustomOrder<FirstOrder, Orders ...>::cmp(const Monomial &a, const Monomial &b) {
         int res = FirstOrder::cmp(a, b);
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <functional>
+#include <type_traits>
 #include <utility>
 
 
@@ -21,6 +23,26 @@ namespace SALIB {
         inline bool operator()(const Monomial& a, const Monomial& b) const;
     };
 
+    // Lex comparison of the first Count variables only, the leading block of an elimination order
+    template <size_t Count>
+    class PrefixLexSemiOrder {
+    public:
+        inline static int cmp(const Monomial& a, const Monomial& b);
+
+        inline bool operator()(const Monomial& a, const Monomial& b) const;
+    };
+
+    // Order for the homogenization of Order with the homogenizing variable at index 0: total degree,
+    // then the smaller power of that variable, then Order. For a graded Order the dehomogenized
+    // Groebner basis is a Groebner basis in Order
+    template <typename Order>
+    class HomogenizedOrder {
+    public:
+        inline static int cmp(const Monomial& a, const Monomial& b);
+
+        inline bool operator()(const Monomial& a, const Monomial& b) const;
+    };
+
     template <typename Order>
     class RevOrder {
     public:
@@ -43,5 +65,15 @@ namespace SALIB {
         inline static int cmp(const Monomial& a, const Monomial& b);
     };
 
+    // Orders that compare the total degree first
+    template <typename Order>
+    struct IsGradedOrder : std::false_type {};
+
+    template <typename ... Orders>
+    struct IsGradedOrder<CustomOrder<MonoGradientSemiOrder, Orders ...>> : std::true_type {};
+
+    template <typename Order>
+    struct IsGradedOrder<HomogenizedOrder<Order>> : std::true_type {};
+
     using DefaultOrder = MonoLexOrder;
 }
\ No newline at end of file
@@ -0,0 +1,192 @@
+#pragma once
+#include "algorithms.h"
+#include "critical_pairs.h"
+#include "thread_pool.h"
+#include "groebner_basis.h"
+#include <vector>
+#include <thread>
+#include <utility>
+#include <algorithm>
+
+namespace SALIB {
+    template <typename CoefficientType, typename Order = DefaultOrder>
+    class ParallelPolyAlg {
+    public:
+        using PolynomialType = Polynomial<CoefficientType, Order>;
+        using PolySet = PolynomialSet<CoefficientType, Order>;
+
+        // Pairs are processed in rounds: S-polynomials of a round are reduced concurrently by a snapshot
+        // of the basis, then new elements are published one by one. There is no concurrent basis that
+        // workers extend while others reduce, a new element only becomes a reducer in the next round
+        inline static void make_groebner_basis(
+            std::vector<PolynomialType>& ideal,
+            PairSelectionStrategy strategy = PairSelectionStrategy::NORMAL,
+            size_t threads_count = std::thread::hardware_concurrency()
+        );
+
+        template <typename SetOrder>
+        inline static PolySet make_groebner_basis(
+            const PolynomialSet<CoefficientType, SetOrder>& ideal,
+            PairSelectionStrategy strategy = PairSelectionStrategy::NORMAL,
+            size_t threads_count = std::thread::hardware_concurrency()
+        );
+
+        inline static PolySet auto_reduce(const PolySet& ideal);
+
+        // Membership bitmap for many polynomials, the basis is computed once and shared by the workers
+        template <typename PolyOrder, typename SetOrder>
+        inline static std::vector<bool> is_in_ideal_batch(
+            const std::vector<Polynomial<CoefficientType, PolyOrder>>& polys,
+            const PolynomialSet<CoefficientType, SetOrder>& ideal,
+            std::vector<PolynomialType>* normal_forms = nullptr,
+            size_t threads_count = std::thread::hardware_concurrency()
+        );
+
+        template <typename PolyOrder>
+        inline static std::vector<bool> is_in_ideal_batch(
+            const std::vector<Polynomial<CoefficientType, PolyOrder>>& polys,
+            const GroebnerBasis<CoefficientType, Order>& basis,
+            std::vector<PolynomialType>* normal_forms = nullptr,
+            size_t threads_count = std::thread::hardware_concurrency()
+        );
+
+    private:
+        inline static std::vector<CriticalPair> select_pairs(
+            PairQueue<Order>& pairs,
+            const std::vector<PolynomialType>& ideal,
+            size_t max_count
+        );
+    };
+
+/*
+=================================IMPLEMENTATION=================================
+*/
+
+    template <typename CoefficientType, typename Order>
+    std::vector<CriticalPair> ParallelPolyAlg<CoefficientType, Order>::select_pairs(
+            PairQueue<Order>& pairs,
+            const std::vector<PolynomialType>& ideal,
+            size_t max_count) {
+        std::vector<CriticalPair> selected;
+        while (!pairs.empty() && selected.size() < max_count) {
+            CriticalPair pair = pairs.pop();
+            if (!pairs.is_redundant(pair, ideal))
+                selected.push_back(std::move(pair));
+        }
+        return selected;
+    }
+
+    template <typename CoefficientType, typename Order>
+    void ParallelPolyAlg<CoefficientType, Order>::make_groebner_basis(
+            std::vector<PolynomialType>& ideal,
+            PairSelectionStrategy strategy,
+            size_t threads_count) {
+        using Alg = PolyAlg<CoefficientType, Order>;
+        if (threads_count == 0)
+            threads_count = 1;
+        // A few pairs per thread keep the workers busy while stealing evens out uneven reductions
+        const size_t round_size = (threads_count == 1) ? 1 : 4 * threads_count;
+
+        ThreadPool pool(threads_count);
+        PairQueue<Order> pairs(strategy);
+        for (size_t idx = 0; idx < ideal.size(); ++idx)
+            pairs.add_element(ideal);
+
+        while (!pairs.empty()) {
+            std::vector<CriticalPair> selected = select_pairs(pairs, ideal, round_size);
+            if (selected.empty())
+                continue;
+
+            // The basis is not modified until every task of the round is finished
+            std::vector<PolynomialType> reduced(selected.size());
+            const std::vector<PolynomialType>& basis = ideal;
+            for (size_t idx = 0; idx < selected.size(); ++idx) {
+                pool.submit([&basis, &selected, &reduced, idx] {
+                    const CriticalPair& pair = selected[idx];
+                    PolynomialType s = PolynomialType::s_polynomial(basis[pair.first], basis[pair.second]);
+                    reduced[idx] = Alg::reduce_by(s, basis);
+                });
+            }
+            pool.wait();
+
+            // Elements published earlier in the round may still reduce the later ones
+            for (size_t idx = 0; idx < selected.size(); ++idx) {
+                if (reduced[idx].is_zero())
+                    continue;
+                PolynomialType s = Alg::reduce_by(reduced[idx], ideal);
+                if (s.is_zero())
+                    continue;
+                ideal.push_back(std::move(s));
+                pairs.add_element(ideal, std::max(selected[idx].sugar, PairQueue<Order>::get_total_degree(ideal.back())));
+            }
+        }
+    }
+
+    template <typename CoefficientType, typename Order>
+    template <typename SetOrder>
+    typename ParallelPolyAlg<CoefficientType, Order>::PolySet
+    ParallelPolyAlg<CoefficientType, Order>::make_groebner_basis(
+            const PolynomialSet<CoefficientType, SetOrder>& ideal,
+            PairSelectionStrategy strategy,
+            size_t threads_count) {
+        std::vector<PolynomialType> new_ideal;
+        new_ideal.reserve(ideal.size());
+        for (const auto& p : ideal) {
+            new_ideal.push_back(PolynomialType(p));
+        }
+        make_groebner_basis(new_ideal, strategy, threads_count);
+        PolySet basis;
+        for (const auto& p : new_ideal) {
+            basis.add(p);
+        }
+        return basis;
+    }
+
+    template <typename CoefficientType, typename Order>
+    typename ParallelPolyAlg<CoefficientType, Order>::PolySet
+    ParallelPolyAlg<CoefficientType, Order>::auto_reduce(const PolySet& ideal) {
+        return PolyAlg<CoefficientType, Order>::auto_reduce(ideal);
+    }
+
+    template <typename CoefficientType, typename Order>
+    template <typename PolyOrder, typename SetOrder>
+    std::vector<bool> ParallelPolyAlg<CoefficientType, Order>::is_in_ideal_batch(
+            const std::vector<Polynomial<CoefficientType, PolyOrder>>& polys,
+            const PolynomialSet<CoefficientType, SetOrder>& ideal,
+            std::vector<PolynomialType>* normal_forms,
+            size_t threads_count) {
+        GroebnerBasis<CoefficientType, Order> basis(ideal);
+        return is_in_ideal_batch(polys, basis, normal_forms, threads_count);
+    }
+
+    template <typename CoefficientType, typename Order>
+    template <typename PolyOrder>
+    std::vector<bool> ParallelPolyAlg<CoefficientType, Order>::is_in_ideal_batch(
+            const std::vector<Polynomial<CoefficientType, PolyOrder>>& polys,
+            const GroebnerBasis<CoefficientType, Order>& basis,
+            std::vector<PolynomialType>* normal_forms,
+            size_t threads_count) {
+        if (threads_count == 0)
+            threads_count = 1;
+        if (normal_forms)
+            normal_forms->assign(polys.size(), PolynomialType());
+        // std::vector<bool> packs bits, so workers write whole bytes
+        std::vector<char> members(polys.size(), 0);
+        const size_t block_size = std::max<size_t>(1, polys.size() / (4 * threads_count));
+
+        ThreadPool pool(threads_count);
+        for (size_t begin = 0; begin < polys.size(); begin += block_size) {
+            size_t end = std::min(polys.size(), begin + block_size);
+            pool.submit([&polys, &basis, &members, normal_forms, begin, end] {
+                for (size_t idx = begin; idx < end; ++idx) {
+                    PolynomialType reduced = basis.reduce(PolynomialType(polys[idx]));
+                    members[idx] = reduced.is_zero();
+                    if (normal_forms)
+                        (*normal_forms)[idx] = std::move(reduced);
+                }
+            });
+        }
+        pool.wait();
+        return std::vector<bool>(members.begin(), members.end());
+    }
+}
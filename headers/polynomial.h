@@ -1,7 +1,12 @@
 #pragma once
 #include "monomial.h"
 #include "orders.h"
+#include "memory_accounting.h"
+#include "trace.h"
 #include <map>
+#include <vector>
+#include <utility>
+#include <algorithm>
 
 namespace SALIB {
     
@@ -9,9 +14,11 @@ namespace SALIB {
     template <typename CoefficientType, typename Order = DefaultOrder>
     class Polynomial {
     public:
-        using MonomialMap = std::map<Monomial, CoefficientType, Order>;
+        using MonomialMap = std::map<Monomial, CoefficientType, Order, AccountedAllocator<
+            std::pair<const Monomial, CoefficientType>, MemoryCategory::POLYNOMIAL_NODES>>;
         using const_iterator = typename MonomialMap::const_iterator;
         using const_reverse_iterator = typename MonomialMap::const_reverse_iterator;
+        using Term = std::pair<Monomial, CoefficientType>;
 
         Polynomial() = default;
         Polynomial(const Monomial& mono);
@@ -19,6 +26,8 @@ namespace SALIB {
         Polynomial(const CoefficientType& coeff);
 
         static Polynomial s_polynomial(const Polynomial& a, const Polynomial& b);
+        // Terms may come in any order and repeat, they are sorted once and inserted in linear time
+        static Polynomial from_terms(std::vector<Term> terms);
 
         template <typename CoefficientTypeOther, typename OrderOther> 
         Polynomial(const Polynomial<CoefficientTypeOther, OrderOther>& other);
@@ -32,6 +41,7 @@ namespace SALIB {
 
         Polynomial& operator+=(const Polynomial& other);
         Polynomial& operator-=(const Polynomial& other);
+        void add_term(const Monomial& mono, const CoefficientType& coeff);
         friend Polynomial<CoefficientType, Order> operator*(const Polynomial<CoefficientType, Order>& a, const Polynomial<CoefficientType, Order>& b) {
             Polynomial<CoefficientType, Order> res;
             for (const auto& it1 : a.monomials) {
@@ -116,6 +126,7 @@ namespace SALIB {
         const Polynomial& a,
         const Polynomial& b
     ) {
+        TraceSpan span("s_polynomial");
         Monomial a_lt = a.get_largest_monomial();
         Monomial b_lt = b.get_largest_monomial();
         Monomial l = Monomial::lcm(a_lt, b_lt);
@@ -177,6 +188,34 @@ namespace SALIB {
         return *this;
     }
 
+    template <typename CoefficientType, typename Order>
+    void Polynomial<CoefficientType, Order>::add_term(const Monomial& mono, const CoefficientType& coeff) {
+        add_and_check(mono, coeff);
+    }
+
+    template <typename CoefficientType, typename Order>
+    Polynomial<CoefficientType, Order> Polynomial<CoefficientType, Order>::from_terms(std::vector<Term> terms) {
+        Order less;
+        auto less_term = [&less](const Term& a, const Term& b) {
+            return less(a.first, b.first);
+        };
+        // Input written from the leading term down is only reversed
+        if (std::is_sorted(terms.rbegin(), terms.rend(), less_term))
+            std::reverse(terms.begin(), terms.end());
+        else if (!std::is_sorted(terms.begin(), terms.end(), less_term))
+            std::sort(terms.begin(), terms.end(), less_term);
+        Polynomial res;
+        for (size_t idx = 0; idx < terms.size();) {
+            size_t next = idx + 1;
+            while (next < terms.size() && !less(terms[idx].first, terms[next].first))
+                terms[idx].second += terms[next++].second;
+            if (terms[idx].second != null_coef)
+                res.monomials.emplace_hint(res.monomials.end(), std::move(terms[idx].first), std::move(terms[idx].second));
+            idx = next;
+        }
+        return res;
+    }
+
     template <typename CoefficientType, typename Order>
     Polynomial<CoefficientType, Order>& Polynomial<CoefficientType, Order>::operator-=(const Polynomial& other) {
         for (const auto& it : other.monomials) {
@@ -0,0 +1,415 @@
+#pragma once
+#include "polynomial.h"
+#include "polynomial_set.h"
+#include "computation_context.h"
+#include "field.h"
+#include <boost/rational.hpp>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <type_traits>
+#include <algorithm>
+#include <iterator>
+#include <cstring>
+
+namespace SALIB {
+    enum class PolynomialFormat {
+        MAPLE,      // var := [...]: sys := [...]: as in test_launcher/tests.txt, read back by MapleReader
+        NUMERIC     // Counts, numerators, denominators and exponents, read back by SpeedTest::read_polyset
+    };
+
+    // Decimal digits without a stream, put_unsigned returns the end of the written digits
+    inline char* put_unsigned(unsigned long long value, char* at);
+    inline void append_unsigned(unsigned long long value, std::string& out);
+    inline void append_integer(long long value, std::string& out);
+
+    // Appends a coefficient as "a", "-a" or "a/b". Types without a specialization go through operator<<
+    template <typename CoefficientType, typename Enable = void>
+    struct CoefficientFormatter {
+        static void append(const CoefficientType& coeff, std::string& out) {
+            std::ostringstream text;
+            text << coeff;
+            out += text.str();
+        }
+    };
+
+    // Formats into one large buffer that goes to the stream in blocks of buffer_size
+    class PolynomialWriter {
+    public:
+        static const size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+
+        inline explicit PolynomialWriter(
+            std::ostream& out,
+            PolynomialFormat format = PolynomialFormat::MAPLE,
+            size_t buffer_size = DEFAULT_BUFFER_SIZE
+        );
+        inline ~PolynomialWriter();
+        PolynomialWriter(const PolynomialWriter&) = delete;
+        PolynomialWriter& operator=(const PolynomialWriter&) = delete;
+
+        // Names used by the MAPLE format, the rest of the variables are x<index>
+        inline void set_variable_names(std::vector<std::string> names);
+
+        // variables_count = 0 means the variables of the polynomials
+        template <typename CoefficientType, typename Order>
+        inline void write_system(const std::vector<Polynomial<CoefficientType, Order>>& polys, size_t variables_count = 0);
+
+        template <typename CoefficientType, typename Order>
+        inline void write_system(const PolynomialSet<CoefficientType, Order>& polys, size_t variables_count = 0);
+
+        // A system of unknown size: polynomials are written as they come. The NUMERIC count is filled in
+        // by end_system, a stream that can not seek keeps the system in memory until then
+        inline void begin_system(size_t variables_count);
+        template <typename CoefficientType, typename Order>
+        inline void write_polynomial(const Polynomial<CoefficientType, Order>& poly);
+        inline void end_system();
+
+        // Writes every new element of a PolyAlg computation on basis as soon as it appears
+        template <typename CoefficientType, typename Order>
+        inline void stream_elements(ComputationContext& context, const std::vector<Polynomial<CoefficientType, Order>>& basis);
+
+        inline void flush();
+
+    private:
+        static const int COUNT_WIDTH = 20;
+
+        inline void append_variable(Monomial::VariableIndexType var);
+        inline void ensure_names(size_t variables_count);
+        // Room for one term, it is formatted there and appended to the buffer at once
+        inline char* prepare_term(const Monomial& mono);
+        inline char* put_name(Monomial::VariableIndexType var, char* at) const;
+        inline void append_count(size_t count);
+        inline void maybe_flush();
+
+        template <typename CoefficientType, typename Order>
+        inline void append_maple(const Polynomial<CoefficientType, Order>& poly);
+        template <typename CoefficientType, typename Order>
+        inline void append_numeric(const Polynomial<CoefficientType, Order>& poly);
+
+        std::ostream& out;
+        PolynomialFormat format;
+        size_t buffer_size;
+        std::string buffer;
+        std::string coefficient;
+        std::vector<std::string> names;
+        size_t longest_name = 0;
+        std::vector<char> term;
+        size_t polynomials_in_system = 0;
+        // Stream position of the NUMERIC count placeholder, -1 if the system is held in the buffer
+        std::streamoff count_position = -1;
+        bool holding = false;
+    };
+
+/*
+=================================IMPLEMENTATION=================================
+*/
+
+    char* put_unsigned(unsigned long long value, char* at) {
+        static const char DIGIT_PAIRS[] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+        char digits[20];
+        char* first = digits + sizeof(digits);
+        while (value >= 100) {
+            unsigned pair = static_cast<unsigned>(value % 100) * 2;
+            value /= 100;
+            *--first = DIGIT_PAIRS[pair + 1];
+            *--first = DIGIT_PAIRS[pair];
+        }
+        if (value >= 10) {
+            *--first = DIGIT_PAIRS[value * 2 + 1];
+            *--first = DIGIT_PAIRS[value * 2];
+        } else {
+            *--first = static_cast<char>('0' + value);
+        }
+        size_t length = static_cast<size_t>(digits + sizeof(digits) - first);
+        std::memcpy(at, first, length);
+        return at + length;
+    }
+
+    void append_unsigned(unsigned long long value, std::string& out) {
+        char digits[20];
+        out.append(digits, static_cast<size_t>(put_unsigned(value, digits) - digits));
+    }
+
+    void append_integer(long long value, std::string& out) {
+        if (value < 0) {
+            out += '-';
+            append_unsigned(0ULL - static_cast<unsigned long long>(value), out);
+        } else {
+            append_unsigned(static_cast<unsigned long long>(value), out);
+        }
+    }
+
+    template <typename IntType>
+    struct CoefficientFormatter<IntType, typename std::enable_if<std::is_integral<IntType>::value>::type> {
+        static void append(IntType coeff, std::string& out) {
+            append_integer(static_cast<long long>(coeff), out);
+        }
+    };
+
+    template <int N>
+    struct CoefficientFormatter<Field<N>> {
+        static void append(const Field<N>& coeff, std::string& out) {
+            append_unsigned(coeff.n, out);
+        }
+    };
+
+    template <typename IntType>
+    struct CoefficientFormatter<boost::rational<IntType>, typename std::enable_if<std::is_integral<IntType>::value>::type> {
+        static void append(const boost::rational<IntType>& coeff, std::string& out) {
+            append_integer(static_cast<long long>(coeff.numerator()), out);
+            if (coeff.denominator() != 1) {
+                out += '/';
+                append_integer(static_cast<long long>(coeff.denominator()), out);
+            }
+        }
+    };
+
+    PolynomialWriter::PolynomialWriter(std::ostream& out, PolynomialFormat format, size_t buffer_size)
+            : out(out), format(format), buffer_size(buffer_size) {
+        buffer.reserve(buffer_size + buffer_size / 8);
+    }
+
+    PolynomialWriter::~PolynomialWriter() {
+        flush();
+    }
+
+    void PolynomialWriter::set_variable_names(std::vector<std::string> new_names) {
+        names = std::move(new_names);
+        longest_name = 0;
+        for (const auto& name : names)
+            longest_name = std::max(longest_name, name.size());
+    }
+
+    void PolynomialWriter::flush() {
+        if (holding)
+            return;
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+        out.flush();
+    }
+
+    void PolynomialWriter::maybe_flush() {
+        if (!holding && buffer.size() >= buffer_size) {
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    }
+
+    void PolynomialWriter::ensure_names(size_t variables_count) {
+        // Default names are generated once and then copied like the given ones
+        while (names.size() < variables_count) {
+            names.push_back("x");
+            append_unsigned(names.size() - 1, names.back());
+            longest_name = std::max(longest_name, names.back().size());
+        }
+    }
+
+    void PolynomialWriter::append_variable(Monomial::VariableIndexType var) {
+        ensure_names(var + 1);
+        buffer += names[var];
+    }
+
+    char* PolynomialWriter::prepare_term(const Monomial& mono) {
+        size_t variables = static_cast<size_t>(mono.end() - mono.begin());
+        ensure_names(variables);
+        // Sign, separators and two numbers of at most 20 digits per variable
+        size_t bound = coefficient.size() + 24 + variables * (longest_name + 44);
+        if (term.size() < bound)
+            term.resize(bound);
+        return term.data();
+    }
+
+    char* PolynomialWriter::put_name(Monomial::VariableIndexType var, char* at) const {
+        const std::string& name = names[var];
+        std::memcpy(at, name.data(), name.size());
+        return at + name.size();
+    }
+
+    void PolynomialWriter::append_count(size_t count) {
+        // Right aligned in a fixed field, so the count can be overwritten in place
+        std::string digits;
+        append_unsigned(count, digits);
+        buffer.append(COUNT_WIDTH - digits.size(), ' ');
+        buffer += digits;
+        buffer += '\n';
+    }
+
+    void PolynomialWriter::begin_system(size_t variables_count) {
+        polynomials_in_system = 0;
+        if (format == PolynomialFormat::MAPLE) {
+            buffer += "var := [";
+            for (size_t var = 0; var < variables_count; ++var) {
+                if (var)
+                    buffer += ", ";
+                append_variable(var);
+            }
+            buffer += "]:\nsys := [";
+            return;
+        }
+        flush();
+        count_position = out.tellp();
+        holding = count_position < 0;
+        if (!holding)
+            append_count(0);
+    }
+
+    void PolynomialWriter::end_system() {
+        if (format == PolynomialFormat::MAPLE) {
+            buffer += "]:\n";
+            maybe_flush();
+            return;
+        }
+        if (holding) {
+            holding = false;
+            std::string body;
+            body.swap(buffer);
+            append_count(polynomials_in_system);
+            buffer += body;
+            return;
+        }
+        flush();
+        std::streampos end_position = out.tellp();
+        out.seekp(count_position);
+        append_count(polynomials_in_system);
+        flush();
+        out.seekp(end_position);
+    }
+
+    template <typename CoefficientType, typename Order>
+    void PolynomialWriter::append_maple(const Polynomial<CoefficientType, Order>& poly) {
+        if (poly.is_zero()) {
+            buffer += '0';
+            return;
+        }
+        // From the leading term down, the order MapleReader inserts without sorting
+        for (auto it = poly.rbegin(); it != poly.rend(); ++it) {
+            const Monomial& mono = it->first;
+            coefficient.clear();
+            CoefficientFormatter<CoefficientType>::append(it->second, coefficient);
+            bool negative = !coefficient.empty() && coefficient[0] == '-';
+            bool unit = coefficient.size() == 1u + negative && coefficient.back() == '1';
+            bool constant = mono.is_zero();
+            char* const start = prepare_term(mono);
+            char* at = start;
+            if (it != poly.rbegin() && !negative)
+                *at++ = '+';
+            if (constant || !unit) {
+                std::memcpy(at, coefficient.data(), coefficient.size());
+                at += coefficient.size();
+            } else if (negative) {
+                *at++ = '-';
+            }
+            bool first_factor = constant || !unit;
+            for (auto var = mono.begin(); var != mono.end(); ++var) {
+                if (*var == 0)
+                    continue;
+                if (first_factor)
+                    *at++ = '*';
+                first_factor = true;
+                at = put_name(static_cast<size_t>(var - mono.begin()), at);
+                if (*var != 1) {
+                    *at++ = '^';
+                    at = put_unsigned(*var, at);
+                }
+            }
+            buffer.append(start, static_cast<size_t>(at - start));
+        }
+    }
+
+    template <typename CoefficientType, typename Order>
+    void PolynomialWriter::append_numeric(const Polynomial<CoefficientType, Order>& poly) {
+        append_unsigned(static_cast<unsigned long long>(std::distance(poly.begin(), poly.end())), buffer);
+        buffer += '\n';
+        for (auto it = poly.rbegin(); it != poly.rend(); ++it) {
+            const Monomial& mono = it->first;
+            coefficient.clear();
+            CoefficientFormatter<CoefficientType>::append(it->second, coefficient);
+            char* const start = prepare_term(mono);
+            char* at = start;
+            std::memcpy(at, coefficient.data(), coefficient.size());
+            size_t slash = coefficient.find('/');
+            if (slash == std::string::npos) {
+                at += coefficient.size();
+                *at++ = ' ';
+                *at++ = '1';
+            } else {
+                at[slash] = ' ';
+                at += coefficient.size();
+            }
+            size_t factors = 0;
+            for (auto var = mono.begin(); var != mono.end(); ++var)
+                factors += *var != 0;
+            *at++ = ' ';
+            at = put_unsigned(factors, at);
+            for (auto var = mono.begin(); var != mono.end(); ++var) {
+                if (*var == 0)
+                    continue;
+                *at++ = ' ';
+                at = put_unsigned(static_cast<unsigned long long>(var - mono.begin()), at);
+                *at++ = ' ';
+                at = put_unsigned(*var, at);
+            }
+            *at++ = '\n';
+            buffer.append(start, static_cast<size_t>(at - start));
+        }
+    }
+
+    template <typename CoefficientType, typename Order>
+    void PolynomialWriter::write_polynomial(const Polynomial<CoefficientType, Order>& poly) {
+        if (format == PolynomialFormat::MAPLE) {
+            if (polynomials_in_system)
+                buffer += ",\n";
+            append_maple(poly);
+        } else {
+            append_numeric(poly);
+        }
+        ++polynomials_in_system;
+        maybe_flush();
+    }
+
+    template <typename CoefficientType, typename Order>
+    void PolynomialWriter::write_system(
+            const std::vector<Polynomial<CoefficientType, Order>>& polys,
+            size_t variables_count) {
+        if (variables_count == 0) {
+            for (const auto& poly : polys) {
+                for (const auto& term : poly) {
+                    for (auto var = term.first.begin(); var != term.first.end(); ++var) {
+                        if (*var != 0)
+                            variables_count = std::max(variables_count, static_cast<size_t>(var - term.first.begin()) + 1);
+                    }
+                }
+            }
+        }
+        if (format == PolynomialFormat::NUMERIC) {
+            // The count is known, nothing has to be patched
+            polynomials_in_system = 0;
+            append_count(polys.size());
+            for (const auto& poly : polys)
+                write_polynomial(poly);
+            return;
+        }
+        begin_system(variables_count);
+        for (const auto& poly : polys)
+            write_polynomial(poly);
+        end_system();
+    }
+
+    template <typename CoefficientType, typename Order>
+    void PolynomialWriter::write_system(const PolynomialSet<CoefficientType, Order>& polys, size_t variables_count) {
+        write_system(std::vector<Polynomial<CoefficientType, Order>>(polys.begin(), polys.end()), variables_count);
+    }
+
+    template <typename CoefficientType, typename Order>
+    void PolynomialWriter::stream_elements(
+            ComputationContext& context,
+            const std::vector<Polynomial<CoefficientType, Order>>& basis) {
+        context.set_element_callback([this, &basis](size_t index) {
+            write_polynomial(basis[index]);
+        });
+    }
+}
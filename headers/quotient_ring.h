@@ -0,0 +1,276 @@
+#pragma once
+#include "polynomial.h"
+#include "polynomial_set.h"
+#include "algorithms.h"
+#include "monomial_ideal.h"
+#include <vector>
+#include <map>
+#include <utility>
+#include <algorithm>
+
+namespace SALIB {
+    // k[x_0, ..., x_{n - 1}] / I for a zero-dimensional ideal given by its Groebner basis.
+    // Elements are dense vectors of coordinates in the standard monomials, multiplication by x_i
+    // is a precomputed sparse matrix, so normal forms need no division by the basis.
+    // For an ideal that is not zero-dimensional the ring is left empty
+    template <typename CoefficientType, typename Order = DefaultOrder>
+    class QuotientRing {
+    public:
+        using PolynomialType = Polynomial<CoefficientType, Order>;
+        using PolySet = PolynomialSet<CoefficientType, Order>;
+        using Vector = std::vector<CoefficientType>;
+        using SparseColumn = std::vector<std::pair<size_t, CoefficientType>>;
+
+        // variables_count = 0 means the variables of the leading monomials
+        inline explicit QuotientRing(const std::vector<PolynomialType>& basis, size_t variables_count = 0);
+
+        template <typename SetOrder>
+        inline explicit QuotientRing(const PolynomialSet<CoefficientType, SetOrder>& basis, size_t variables_count = 0);
+
+        inline bool is_zero_dimensional() const;
+        // Dimension of the ring as a vector space
+        inline size_t dimension() const;
+        inline size_t get_variables_count() const;
+
+        // Ascending in Order, 1 comes first unless the ideal is the unit ideal
+        inline const std::vector<Monomial>& get_standard_monomials() const;
+        // Column j is the normal form of x_var * s_j
+        inline const std::vector<SparseColumn>& get_multiplication_matrix(Monomial::VariableIndexType var) const;
+
+        // poly may only use the variables of the ring
+        inline Vector normal_form(const PolynomialType& poly) const;
+        inline PolynomialType to_polynomial(const Vector& coordinates) const;
+        // Same result as PolyAlg::reduce_by with the reduced basis
+        inline PolynomialType reduce(const PolynomialType& poly) const;
+
+        inline Vector multiply_by_variable(const Vector& coordinates, Monomial::VariableIndexType var) const;
+        inline Vector multiply(const Vector& a, const Vector& b) const;
+
+    private:
+        using Term = std::pair<Monomial, CoefficientType>;
+
+        inline void build(const std::vector<PolynomialType>& basis, size_t variables_count);
+        inline void add_product(const Vector& coordinates, Monomial::VariableIndexType var, Vector& res) const;
+        // Terms with a non-standard monomial are split as x_i * rest for their last variable x_i,
+        // the rests of one variable are reduced together and multiplied by the matrix of x_i
+        inline void reduce_terms(const std::vector<Term>& terms, Vector& res) const;
+
+        bool zero_dimensional = false;
+        size_t variables_count = 0;
+        std::vector<Monomial> standard;
+        std::map<Monomial, size_t, Order> index_of;
+        // For every standard monomial but 1: a variable x and the index of s / x
+        std::vector<std::pair<Monomial::VariableIndexType, size_t>> parent;
+        std::vector<std::vector<SparseColumn>> matrices;
+    };
+
+/*
+=================================IMPLEMENTATION=================================
+*/
+
+    template <typename CoefficientType, typename Order>
+    QuotientRing<CoefficientType, Order>::QuotientRing(const std::vector<PolynomialType>& basis, size_t variables_count) {
+        build(basis, variables_count);
+    }
+
+    template <typename CoefficientType, typename Order>
+    template <typename SetOrder>
+    QuotientRing<CoefficientType, Order>::QuotientRing(
+            const PolynomialSet<CoefficientType, SetOrder>& basis,
+            size_t variables_count) {
+        std::vector<PolynomialType> polys;
+        for (const auto& poly : basis)
+            polys.push_back(PolynomialType(poly));
+        build(polys, variables_count);
+    }
+
+    template <typename CoefficientType, typename Order>
+    void QuotientRing<CoefficientType, Order>::build(const std::vector<PolynomialType>& basis, size_t count) {
+        MonomialIdeal leading = MonomialIdeal::from_leading_monomials(basis, count);
+        variables_count = leading.get_variables_count();
+        zero_dimensional = leading.is_zero_dimensional();
+        if (!zero_dimensional)
+            return;
+
+        // Standard monomials are closed under division, so they are reached from 1 one variable at a time
+        std::vector<Monomial> stack;
+        std::map<Monomial, bool, Order> seen;
+        if (!leading.contains(Monomial())) {
+            stack.push_back(Monomial());
+            seen[Monomial()] = true;
+        }
+        while (!stack.empty()) {
+            Monomial mono = std::move(stack.back());
+            stack.pop_back();
+            for (size_t var = 0; var < variables_count; ++var) {
+                Monomial next = mono * Monomial(var, 1);
+                if (seen.count(next) || leading.contains(next))
+                    continue;
+                seen[next] = true;
+                stack.push_back(std::move(next));
+            }
+            standard.push_back(std::move(mono));
+        }
+        std::sort(standard.begin(), standard.end(), [](const Monomial& a, const Monomial& b) {
+            return Order::cmp(a, b) < 0;
+        });
+        for (size_t idx = 0; idx < standard.size(); ++idx)
+            index_of[standard[idx]] = idx;
+
+        parent.resize(standard.size());
+        for (size_t idx = 0; idx < standard.size(); ++idx) {
+            const Monomial& mono = standard[idx];
+            for (size_t var = 0; var < variables_count; ++var) {
+                if (mono[var] != 0) {
+                    parent[idx] = std::make_pair(var, index_of[mono / Monomial(var, 1)]);
+                    break;
+                }
+            }
+        }
+
+        // Border monomials x_i * s_j are reduced by the basis once
+        using Alg = PolyAlg<CoefficientType, Order>;
+        matrices.assign(variables_count, std::vector<SparseColumn>(standard.size()));
+        for (size_t var = 0; var < variables_count; ++var) {
+            for (size_t idx = 0; idx < standard.size(); ++idx) {
+                Monomial product = standard[idx] * Monomial(var, 1);
+                auto it = index_of.find(product);
+                SparseColumn& column = matrices[var][idx];
+                if (it != index_of.end()) {
+                    column.emplace_back(it->second, CoefficientType(1));
+                    continue;
+                }
+                PolynomialType reduced = Alg::reduce_by(PolynomialType(CoefficientType(1), product), basis);
+                for (const auto& term : reduced)
+                    column.emplace_back(index_of[term.first], term.second);
+            }
+        }
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool QuotientRing<CoefficientType, Order>::is_zero_dimensional() const {
+        return zero_dimensional;
+    }
+
+    template <typename CoefficientType, typename Order>
+    size_t QuotientRing<CoefficientType, Order>::dimension() const {
+        return standard.size();
+    }
+
+    template <typename CoefficientType, typename Order>
+    size_t QuotientRing<CoefficientType, Order>::get_variables_count() const {
+        return variables_count;
+    }
+
+    template <typename CoefficientType, typename Order>
+    const std::vector<Monomial>& QuotientRing<CoefficientType, Order>::get_standard_monomials() const {
+        return standard;
+    }
+
+    template <typename CoefficientType, typename Order>
+    const std::vector<typename QuotientRing<CoefficientType, Order>::SparseColumn>&
+    QuotientRing<CoefficientType, Order>::get_multiplication_matrix(Monomial::VariableIndexType var) const {
+        return matrices[var];
+    }
+
+    template <typename CoefficientType, typename Order>
+    void QuotientRing<CoefficientType, Order>::add_product(
+            const Vector& coordinates,
+            Monomial::VariableIndexType var,
+            Vector& res) const {
+        const CoefficientType zero = CoefficientType(0);
+        const std::vector<SparseColumn>& matrix = matrices[var];
+        for (size_t idx = 0; idx < coordinates.size(); ++idx) {
+            if (coordinates[idx] == zero)
+                continue;
+            for (const auto& entry : matrix[idx])
+                res[entry.first] += coordinates[idx] * entry.second;
+        }
+    }
+
+    template <typename CoefficientType, typename Order>
+    typename QuotientRing<CoefficientType, Order>::Vector
+    QuotientRing<CoefficientType, Order>::multiply_by_variable(
+            const Vector& coordinates,
+            Monomial::VariableIndexType var) const {
+        Vector res(standard.size(), CoefficientType(0));
+        add_product(coordinates, var, res);
+        return res;
+    }
+
+    template <typename CoefficientType, typename Order>
+    typename QuotientRing<CoefficientType, Order>::Vector
+    QuotientRing<CoefficientType, Order>::multiply(const Vector& a, const Vector& b) const {
+        // a * s_j = x * (a * s_parent), standard monomials come after their parents
+        const CoefficientType zero = CoefficientType(0);
+        Vector res(standard.size(), zero);
+        if (standard.empty())
+            return res;
+        size_t last_needed = 0;
+        for (size_t idx = 0; idx < b.size(); ++idx) {
+            if (b[idx] != zero)
+                last_needed = idx;
+        }
+        std::vector<Vector> products(last_needed + 1);
+        products[0] = a;
+        for (size_t idx = 1; idx <= last_needed; ++idx)
+            products[idx] = multiply_by_variable(products[parent[idx].second], parent[idx].first);
+        for (size_t idx = 0; idx <= last_needed; ++idx) {
+            if (b[idx] == zero)
+                continue;
+            for (size_t k = 0; k < res.size(); ++k)
+                res[k] += b[idx] * products[idx][k];
+        }
+        return res;
+    }
+
+    template <typename CoefficientType, typename Order>
+    void QuotientRing<CoefficientType, Order>::reduce_terms(const std::vector<Term>& terms, Vector& res) const {
+        std::vector<std::vector<Term>> rests(variables_count);
+        for (const auto& term : terms) {
+            auto it = index_of.find(term.first);
+            if (it != index_of.end()) {
+                res[it->second] += term.second;
+                continue;
+            }
+            size_t var = static_cast<size_t>(term.first.end() - term.first.begin());
+            while (term.first[--var] == 0) {}
+            rests[var].emplace_back(term.first / Monomial(var, 1), term.second);
+        }
+        for (size_t var = 0; var < variables_count; ++var) {
+            if (rests[var].empty())
+                continue;
+            Vector part(standard.size(), CoefficientType(0));
+            reduce_terms(rests[var], part);
+            add_product(part, var, res);
+        }
+    }
+
+    template <typename CoefficientType, typename Order>
+    typename QuotientRing<CoefficientType, Order>::Vector
+    QuotientRing<CoefficientType, Order>::normal_form(const PolynomialType& poly) const {
+        Vector res(standard.size(), CoefficientType(0));
+        if (standard.empty())
+            return res;
+        std::vector<Term> terms(poly.begin(), poly.end());
+        reduce_terms(terms, res);
+        return res;
+    }
+
+    template <typename CoefficientType, typename Order>
+    typename QuotientRing<CoefficientType, Order>::PolynomialType
+    QuotientRing<CoefficientType, Order>::to_polynomial(const Vector& coordinates) const {
+        PolynomialType res;
+        for (size_t idx = 0; idx < coordinates.size(); ++idx) {
+            if (coordinates[idx] != CoefficientType(0))
+                res += PolynomialType(coordinates[idx], standard[idx]);
+        }
+        return res;
+    }
+
+    template <typename CoefficientType, typename Order>
+    typename QuotientRing<CoefficientType, Order>::PolynomialType
+    QuotientRing<CoefficientType, Order>::reduce(const PolynomialType& poly) const {
+        return to_polynomial(normal_form(poly));
+    }
+}
@@ -0,0 +1,416 @@
+#pragma once
+#include "algorithms.h"
+#include <vector>
+#include <queue>
+#include <utility>
+
+namespace SALIB {
+    // Signature m * e_index of a module element, compared by m * LT(f_index) in the polynomial order, then by index
+    struct Signature {
+        size_t index;
+        Monomial monomial;
+    };
+
+    struct SignatureStatistics {
+        size_t pairs_considered = 0;
+        size_t syzygy_criterion = 0;     // Dropped because a syzygy signature divides theirs
+        size_t rewritable_criterion = 0; // Dropped because a later element with dividing signature exists
+        size_t singular_reductions = 0;  // Top reduced by an element of the same signature
+        size_t zero_reductions = 0;
+
+        // Each eliminated pair is an S-polynomial Buchberger would reduce, mostly to zero
+        inline size_t avoided_reductions() const {
+            return syzygy_criterion + rewritable_criterion;
+        }
+    };
+
+    template <typename CoefficientType, typename Order = DefaultOrder>
+    class SignatureAlg {
+    public:
+        using PolynomialType = Polynomial<CoefficientType, Order>;
+        using PolySet = PolynomialSet<CoefficientType, Order>;
+
+        inline static void make_groebner_basis(
+            std::vector<PolynomialType>& ideal,
+            SignatureStatistics* statistics = nullptr
+        );
+
+        template <typename SetOrder>
+        inline static PolySet make_groebner_basis(
+            const PolynomialSet<CoefficientType, SetOrder>& ideal,
+            SignatureStatistics* statistics = nullptr
+        );
+
+        inline static PolySet auto_reduce(const PolySet& ideal);
+
+        template <typename PolyOrder, typename SetOrder>
+        inline static PolynomialType reduce_by(
+            const Polynomial<CoefficientType, PolyOrder>& divider,
+            const PolynomialSet<CoefficientType, SetOrder>& divisors
+        );
+
+        template <typename PolyOrder, typename SetOrder>
+        inline static bool is_polynomial_in_ideal(
+            const Polynomial<CoefficientType, PolyOrder>& poly,
+            const PolynomialSet<CoefficientType, SetOrder>& ideal
+        );
+
+        template <typename PolyOrder, typename SetOrder>
+        inline static bool is_polynomial_in_radical(
+            const Polynomial<CoefficientType, PolyOrder>& poly,
+            const PolynomialSet<CoefficientType, SetOrder>& ideal,
+            Monomial::VariableIndexType free_variable
+        );
+
+        template <typename SetOrder>
+        inline static PolySet intersect_ideals(
+            const PolynomialSet<CoefficientType, SetOrder>& ideal1,
+            const PolynomialSet<CoefficientType, SetOrder>& ideal2,
+            Monomial::VariableIndexType free_variable
+        );
+
+    private:
+        struct LabeledPolynomial {
+            Signature signature;
+            PolynomialType poly;
+        };
+
+        // Multiple of basis[source] (or of the generator when source is empty) with the given signature
+        struct SignaturePair {
+            Signature signature;
+            size_t source;
+            Monomial multiplier;
+        };
+
+        class SignaturePairGreater {
+        public:
+            inline explicit SignaturePairGreater(const std::vector<Monomial>& leads);
+
+            inline bool operator()(const SignaturePair& a, const SignaturePair& b) const;
+        private:
+            const std::vector<Monomial>* leads;
+        };
+
+        using PairHeap = std::priority_queue<SignaturePair, std::vector<SignaturePair>, SignaturePairGreater>;
+
+        // Schreyer order on the generator leading terms: it agrees with Order inside one index, so the
+        // Koszul syzygies get the signatures add_pairs gives them for any input and any Order
+        inline static int cmp(
+            const Signature& a,
+            const Signature& b,
+            const std::vector<Monomial>& leads
+        );
+
+        inline static bool is_syzygy_signature(
+            const Signature& signature,
+            const std::vector<Signature>& syzygies
+        );
+
+        inline static void add_syzygy(const Signature& signature, std::vector<Signature>& syzygies);
+
+        inline static bool is_rewritable(
+            const SignaturePair& pair,
+            const std::vector<LabeledPolynomial>& basis
+        );
+
+        // Returns false if the polynomial turned out to be singular top reducible
+        inline static bool regular_reduce(
+            PolynomialType& poly,
+            const Signature& signature,
+            const std::vector<LabeledPolynomial>& basis,
+            const std::vector<Monomial>& leads
+        );
+
+        // Records the Koszul syzygies of the last basis element and enqueues its regular pairs
+        inline static void add_pairs(
+            const std::vector<LabeledPolynomial>& basis,
+            const std::vector<Monomial>& leads,
+            std::vector<Signature>& syzygies,
+            PairHeap& pairs,
+            SignatureStatistics& stats
+        );
+
+        static const size_t no_source = static_cast<size_t>(-1);
+    };
+
+/*
+=================================IMPLEMENTATION=================================
+*/
+
+    template <typename CoefficientType, typename Order>
+    int SignatureAlg<CoefficientType, Order>::cmp(
+            const Signature& a,
+            const Signature& b,
+            const std::vector<Monomial>& leads) {
+        int res = Order::cmp(a.monomial * leads[a.index], b.monomial * leads[b.index]);
+        if (res != 0 || a.index == b.index)
+            return res;
+        return a.index < b.index ? -1 : 1;
+    }
+
+    template <typename CoefficientType, typename Order>
+    SignatureAlg<CoefficientType, Order>::SignaturePairGreater::SignaturePairGreater(
+            const std::vector<Monomial>& leads) : leads(&leads) {}
+
+    template <typename CoefficientType, typename Order>
+    bool SignatureAlg<CoefficientType, Order>::SignaturePairGreater::operator()(
+            const SignaturePair& a,
+            const SignaturePair& b) const {
+        return cmp(a.signature, b.signature, *leads) > 0;
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool SignatureAlg<CoefficientType, Order>::is_syzygy_signature(
+            const Signature& signature,
+            const std::vector<Signature>& syzygies) {
+        for (const auto& syzygy : syzygies) {
+            if (syzygy.index == signature.index && signature.monomial.is_dividable_by(syzygy.monomial))
+                return true;
+        }
+        return false;
+    }
+
+    template <typename CoefficientType, typename Order>
+    void SignatureAlg<CoefficientType, Order>::add_syzygy(
+            const Signature& signature,
+            std::vector<Signature>& syzygies) {
+        if (!is_syzygy_signature(signature, syzygies))
+            syzygies.push_back(signature);
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool SignatureAlg<CoefficientType, Order>::is_rewritable(
+            const SignaturePair& pair,
+            const std::vector<LabeledPolynomial>& basis) {
+        if (pair.source == no_source)
+            return false;
+        for (size_t idx = pair.source + 1; idx < basis.size(); ++idx) {
+            const Signature& rewriter = basis[idx].signature;
+            if (rewriter.index == pair.signature.index &&
+                pair.signature.monomial.is_dividable_by(rewriter.monomial))
+                return true;
+        }
+        return false;
+    }
+
+    template <typename CoefficientType, typename Order>
+    bool SignatureAlg<CoefficientType, Order>::regular_reduce(
+            PolynomialType& poly,
+            const Signature& signature,
+            const std::vector<LabeledPolynomial>& basis,
+            const std::vector<Monomial>& leads) {
+        PolynomialType rest;
+        bool is_top = true;
+        while (!poly.is_zero()) {
+            const Monomial& lt = poly.get_largest_monomial();
+            bool reduced = false;
+            bool singular = false;
+            for (const auto& element : basis) {
+                const Monomial& element_lt = element.poly.get_largest_monomial();
+                if (!lt.is_dividable_by(element_lt))
+                    continue;
+                Monomial multiplier = lt / element_lt;
+                Signature reducer_signature{element.signature.index, element.signature.monomial * multiplier};
+                int res = cmp(reducer_signature, signature, leads);
+                if (res == 0)
+                    singular = true;
+                if (res >= 0)
+                    continue;
+                PolynomialType subs(poly[lt] / element.poly[element_lt], multiplier);
+                poly -= subs * element.poly;
+                reduced = true;
+                break;
+            }
+            if (reduced)
+                continue;
+            if (is_top && singular)
+                return false;
+            is_top = false;
+            PolynomialType lt_poly = poly.get_largest_monomial_as_poly();
+            rest += lt_poly;
+            poly -= lt_poly;
+        }
+        poly = rest;
+        return true;
+    }
+
+    template <typename CoefficientType, typename Order>
+    void SignatureAlg<CoefficientType, Order>::add_pairs(
+            const std::vector<LabeledPolynomial>& basis,
+            const std::vector<Monomial>& leads,
+            std::vector<Signature>& syzygies,
+            PairHeap& pairs,
+            SignatureStatistics& stats) {
+        size_t added = basis.size() - 1;
+        const LabeledPolynomial& b = basis[added];
+        const Monomial& b_lt = b.poly.get_largest_monomial();
+        for (size_t idx = 0; idx < added; ++idx) {
+            const LabeledPolynomial& c = basis[idx];
+            const Monomial& c_lt = c.poly.get_largest_monomial();
+            // Koszul syzygy c * e_b - b * e_c
+            Signature b_koszul{b.signature.index, b.signature.monomial * c_lt};
+            Signature c_koszul{c.signature.index, c.signature.monomial * b_lt};
+            int koszul_res = cmp(b_koszul, c_koszul, leads);
+            if (koszul_res != 0)
+                add_syzygy(koszul_res > 0 ? b_koszul : c_koszul, syzygies);
+        }
+        for (size_t idx = 0; idx < added; ++idx) {
+            const LabeledPolynomial& c = basis[idx];
+            const Monomial& c_lt = c.poly.get_largest_monomial();
+            Monomial lcm = Monomial::lcm(b_lt, c_lt);
+            Monomial b_multiplier = lcm / b_lt;
+            Monomial c_multiplier = lcm / c_lt;
+            Signature b_signature{b.signature.index, b.signature.monomial * b_multiplier};
+            Signature c_signature{c.signature.index, c.signature.monomial * c_multiplier};
+            int res = cmp(b_signature, c_signature, leads);
+            if (res == 0)
+                continue;
+            SignaturePair pair = (res > 0)
+                ? SignaturePair{std::move(b_signature), added, std::move(b_multiplier)}
+                : SignaturePair{std::move(c_signature), idx, std::move(c_multiplier)};
+            if (is_syzygy_signature(pair.signature, syzygies)) {
+                ++stats.syzygy_criterion;
+                continue;
+            }
+            pairs.push(std::move(pair));
+        }
+    }
+
+    template <typename CoefficientType, typename Order>
+    void SignatureAlg<CoefficientType, Order>::make_groebner_basis(
+            std::vector<PolynomialType>& ideal,
+            SignatureStatistics* statistics) {
+        SignatureStatistics local_statistics;
+        SignatureStatistics& stats = statistics ? *statistics : local_statistics;
+        std::vector<LabeledPolynomial> basis;
+        std::vector<Signature> syzygies;
+        std::vector<Monomial> leads;
+
+        leads.reserve(ideal.size());
+        for (const auto& poly : ideal)
+            leads.push_back(poly.is_zero() ? Monomial() : poly.get_largest_monomial());
+
+        PairHeap pairs{SignaturePairGreater(leads)};
+        for (size_t k = 0; k < ideal.size(); ++k) {
+            if (!ideal[k].is_zero())
+                pairs.push(SignaturePair{Signature{k, Monomial()}, no_source, Monomial()});
+        }
+
+        bool has_last = false;
+        Signature last;
+        while (!pairs.empty()) {
+            SignaturePair pair = pairs.top();
+            pairs.pop();
+            if (has_last && cmp(last, pair.signature, leads) == 0)
+                continue;
+            ++stats.pairs_considered;
+
+            if (is_syzygy_signature(pair.signature, syzygies)) {
+                ++stats.syzygy_criterion;
+                continue;
+            }
+            // Another pair of this signature may still come from the rewriter, so it is not marked as done yet
+            if (is_rewritable(pair, basis)) {
+                ++stats.rewritable_criterion;
+                continue;
+            }
+            has_last = true;
+            last = pair.signature;
+
+            PolynomialType poly = (pair.source == no_source)
+                ? ideal[pair.signature.index]
+                : basis[pair.source].poly * PolynomialType(pair.multiplier);
+            if (!regular_reduce(poly, pair.signature, basis, leads)) {
+                ++stats.singular_reductions;
+                continue;
+            }
+            if (poly.is_zero()) {
+                ++stats.zero_reductions;
+                add_syzygy(pair.signature, syzygies);
+                continue;
+            }
+
+            poly *= PolynomialType(CoefficientType(1) / poly[poly.get_largest_monomial()]);
+            // The ideal is the whole ring, nothing left to compute
+            if (poly.get_largest_monomial().is_zero()) {
+                ideal.assign(1, poly);
+                return;
+            }
+            basis.push_back(LabeledPolynomial{pair.signature, poly});
+            add_pairs(basis, leads, syzygies, pairs, stats);
+        }
+
+        ideal.clear();
+        for (auto& element : basis)
+            ideal.push_back(std::move(element.poly));
+    }
+
+    template <typename CoefficientType, typename Order>
+    template <typename SetOrder>
+    typename SignatureAlg<CoefficientType, Order>::PolySet
+    SignatureAlg<CoefficientType, Order>::make_groebner_basis(
+            const PolynomialSet<CoefficientType, SetOrder>& ideal,
+            SignatureStatistics* statistics) {
+        std::vector<PolynomialType> new_ideal;
+        new_ideal.reserve(ideal.size());
+        for (const auto& p : ideal) {
+            new_ideal.push_back(PolynomialType(p));
+        }
+        make_groebner_basis(new_ideal, statistics);
+        PolySet basis;
+        for (const auto& p : new_ideal) {
+            basis.add(p);
+        }
+        return basis;
+    }
+
+    template <typename CoefficientType, typename Order>
+    typename SignatureAlg<CoefficientType, Order>::PolySet
+    SignatureAlg<CoefficientType, Order>::auto_reduce(const PolySet& ideal) {
+        return PolyAlg<CoefficientType, Order>::auto_reduce(ideal);
+    }
+
+    template <typename CoefficientType, typename Order>
+    template <typename PolyOrder, typename SetOrder>
+    typename SignatureAlg<CoefficientType, Order>::PolynomialType
+    SignatureAlg<CoefficientType, Order>::reduce_by(
+            const Polynomial<CoefficientType, PolyOrder>& divider,
+            const PolynomialSet<CoefficientType, SetOrder>& divisors) {
+        return PolyAlg<CoefficientType, Order>::reduce_by(divider, divisors);
+    }
+
+    template <typename CoefficientType, typename Order>
+    template <typename PolyOrder, typename SetOrder>
+    bool SignatureAlg<CoefficientType, Order>::is_polynomial_in_ideal(
+            const Polynomial<CoefficientType, PolyOrder>& poly,
+            const PolynomialSet<CoefficientType, SetOrder>& ideal) {
+        PolySet basis = make_groebner_basis(ideal);
+        return reduce_by(poly, basis).is_zero();
+    }
+
+    template <typename CoefficientType, typename Order>
+    template <typename PolyOrder, typename SetOrder>
+    bool SignatureAlg<CoefficientType, Order>::is_polynomial_in_radical(
+            const Polynomial<CoefficientType, PolyOrder>& poly,
+            const PolynomialSet<CoefficientType, SetOrder>& ideal,
+            Monomial::VariableIndexType free_variable) {
+        // The Rabinowitsch step is PolyAlg's, it only processes the pairs of the new generator
+        std::vector<PolynomialType> basis;
+        basis.reserve(ideal.size());
+        for (const auto& p : ideal)
+            basis.push_back(PolynomialType(p));
+        make_groebner_basis(basis);
+        return PolyAlg<CoefficientType, Order>::is_polynomial_in_radical(PolynomialType(poly), basis, free_variable);
+    }
+
+    template <typename CoefficientType, typename Order>
+    template <typename SetOrder>
+    typename SignatureAlg<CoefficientType, Order>::PolySet
+    SignatureAlg<CoefficientType, Order>::intersect_ideals(
+            const PolynomialSet<CoefficientType, SetOrder>& ideal1,
+            const PolynomialSet<CoefficientType, SetOrder>& ideal2,
+            Monomial::VariableIndexType free_variable) {
+        // Needs a basis in an elimination order, which PolyAlg computes
+        return PolyAlg<CoefficientType, Order>::intersect_ideals(ideal1, ideal2, free_variable);
+    }
+}
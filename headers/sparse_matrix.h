@@ -0,0 +1,164 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <iostream>
+
+namespace SALIB {
+    template <typename CoefficientType>
+    class SparseMatrix {
+    public:
+        using ColumnIndexType = size_t;
+        using Entry = std::pair<ColumnIndexType, CoefficientType>;
+        using Row = std::vector<Entry>;  // Sorted by column, first entry is the pivot
+        using const_iterator = typename std::vector<Row>::const_iterator;
+
+        inline explicit SparseMatrix(size_t columns_count = 0);
+
+        inline void add_row(Row row);
+
+        inline size_t rows_count() const;
+        inline size_t columns_count() const;
+
+        inline const Row& operator[](size_t row_index) const;
+
+        // Brings the matrix to row echelon form with monic pivots and drops zero rows
+        inline void row_echelon_form();
+
+        inline const_iterator begin() const;
+        inline const_iterator end() const;
+
+        // Text dump: "rows columns", then a line "size column value ..." per row
+        inline void write(std::ostream& out) const;
+        inline static SparseMatrix read(std::istream& in);
+
+    private:
+        inline static void reduce_row(Row& row, const std::vector<Row>& pivots,
+                                      std::vector<CoefficientType>& dense);
+
+        std::vector<Row> rows;
+        size_t columns;
+    };
+
+/*
+=================================IMPLEMENTATION=================================
+*/
+
+    template <typename CoefficientType>
+    SparseMatrix<CoefficientType>::SparseMatrix(size_t columns_count) : columns(columns_count) {}
+
+    template <typename CoefficientType>
+    void SparseMatrix<CoefficientType>::add_row(Row row) {
+        if (!row.empty())
+            rows.push_back(std::move(row));
+    }
+
+    template <typename CoefficientType>
+    size_t SparseMatrix<CoefficientType>::rows_count() const {
+        return rows.size();
+    }
+
+    template <typename CoefficientType>
+    size_t SparseMatrix<CoefficientType>::columns_count() const {
+        return columns;
+    }
+
+    template <typename CoefficientType>
+    const typename SparseMatrix<CoefficientType>::Row& SparseMatrix<CoefficientType>::operator[](size_t row_index) const {
+        return rows[row_index];
+    }
+
+    template <typename CoefficientType>
+    void SparseMatrix<CoefficientType>::reduce_row(
+            Row& row,
+            const std::vector<Row>& pivots,
+            std::vector<CoefficientType>& dense) {
+        const CoefficientType zero = CoefficientType(0);
+        ColumnIndexType first = row.front().first;
+        for (const auto& entry : row)
+            dense[entry.first] = entry.second;
+        row.clear();
+        for (ColumnIndexType col = first; col < dense.size(); ++col) {
+            if (dense[col] == zero)
+                continue;
+            if (!pivots[col].empty()) {
+                CoefficientType factor = dense[col];
+                for (const auto& entry : pivots[col])
+                    dense[entry.first] -= factor * entry.second;
+            } else {
+                row.emplace_back(col, dense[col]);
+            }
+            dense[col] = zero;
+        }
+    }
+
+    template <typename CoefficientType>
+    void SparseMatrix<CoefficientType>::row_echelon_form() {
+        std::vector<Row> pivots(columns);
+        std::vector<CoefficientType> dense(columns, CoefficientType(0));
+        std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) {
+            if (a.front().first != b.front().first)
+                return a.front().first < b.front().first;
+            return a.size() < b.size();
+        });
+        for (auto& row : rows) {
+            if (!pivots[row.front().first].empty())
+                reduce_row(row, pivots, dense);
+            if (row.empty())
+                continue;
+            CoefficientType lead = row.front().second;
+            if (lead != CoefficientType(1)) {
+                for (auto& entry : row)
+                    entry.second /= lead;
+            }
+            pivots[row.front().first] = std::move(row);
+        }
+        rows.clear();
+        for (auto& pivot : pivots) {
+            if (!pivot.empty())
+                rows.push_back(std::move(pivot));
+        }
+    }
+
+    template <typename CoefficientType>
+    typename SparseMatrix<CoefficientType>::const_iterator SparseMatrix<CoefficientType>::begin() const {
+        return rows.begin();
+    }
+
+    template <typename CoefficientType>
+    typename SparseMatrix<CoefficientType>::const_iterator SparseMatrix<CoefficientType>::end() const {
+        return rows.end();
+    }
+
+    template <typename CoefficientType>
+    void SparseMatrix<CoefficientType>::write(std::ostream& out) const {
+        out << rows.size() << " " << columns << "\n";
+        for (const auto& row : rows) {
+            out << row.size();
+            for (const auto& entry : row)
+                out << " " << entry.first << " " << entry.second;
+            out << "\n";
+        }
+    }
+
+    template <typename CoefficientType>
+    SparseMatrix<CoefficientType> SparseMatrix<CoefficientType>::read(std::istream& in) {
+        size_t rows_count = 0, columns_count = 0;
+        in >> rows_count >> columns_count;
+        SparseMatrix matrix(columns_count);
+        for (size_t idx = 0; idx < rows_count && in; ++idx) {
+            size_t row_size = 0;
+            in >> row_size;
+            Row row;
+            row.reserve(row_size);
+            for (size_t entry = 0; entry < row_size; ++entry) {
+                ColumnIndexType col;
+                long long value;
+                in >> col >> value;
+                row.emplace_back(col, CoefficientType(value));
+            }
+            matrix.add_row(std::move(row));
+        }
+        return matrix;
+    }
+}
@@ -5,6 +5,7 @@
 #include <string>
 #include <boost/rational.hpp>
 #include <vector>
+#include <thread>
 #include <boost/multiprecision/gmp.hpp>
 
 #include "polynomial.h"
@@ -12,6 +13,10 @@
 #include "algebra_io.h"
 #include "tests.h"
 #include "algorithms.h"
+#include "f4.h"
+#include "signature_algorithms.h"
+#include "parallel_algorithms.h"
+#include "homogeneous_algorithms.h"
 #include "speed_tests.h"
 #include "stopwatch.h"
 #include "orders.h"
@@ -63,16 +68,89 @@ namespace SpeedTest {
         return res;
     }
 
+    enum class BasisAlgorithm {
+        BUCHBERGER,
+        F4,
+        SIGNATURE,
+        PARALLEL,
+        HOMOGENIZED     // Experimental, see HomogenizedPolyAlg. Only used when asked for by name
+    };
+
+    inline std::string to_string(BasisAlgorithm algorithm) {
+        switch (algorithm) {
+            case BasisAlgorithm::BUCHBERGER:
+                return "buchberger";
+            case BasisAlgorithm::F4:
+                return "f4";
+            case BasisAlgorithm::SIGNATURE:
+                return "signature";
+            case BasisAlgorithm::PARALLEL:
+                return "parallel";
+            case BasisAlgorithm::HOMOGENIZED:
+                return "homogenized";
+        }
+        return "unknown";
+    }
+
+    inline bool parse_basis_algorithm(const std::string& name, BasisAlgorithm& algorithm) {
+        for (auto candidate : {BasisAlgorithm::BUCHBERGER, BasisAlgorithm::F4,
+                               BasisAlgorithm::SIGNATURE, BasisAlgorithm::PARALLEL,
+                               BasisAlgorithm::HOMOGENIZED}) {
+            if (to_string(candidate) == name) {
+                algorithm = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Only the Buchberger algorithm is stopped by the limits of the context
     template <typename CoefficientType, typename Order>
-    PolynomialSet<CoefficientType, Order> calc_basis_and_reduce(const PolynomialSet<CoefficientType, Order>& ideal) {
+    PolynomialSet<CoefficientType, Order> calc_basis_and_reduce(
+        const PolynomialSet<CoefficientType, Order>& ideal,
+        PairSelectionStrategy strategy = PairSelectionStrategy::NORMAL,
+        BasisAlgorithm algorithm = BasisAlgorithm::BUCHBERGER,
+        size_t threads_count = std::thread::hardware_concurrency(),
+        BuchbergerStatistics* statistics = nullptr,
+        ComputationContext* context = nullptr
+    ) {
         using Poly = Polynomial<CoefficientType, Order>;
         using CurrentPolyAlg = PolyAlg<CoefficientType, Order>;
         using PolySet = PolynomialSet<CoefficientType, Order>;
 
         CurrentPolyAlg algo;
-        auto reduced_ideal = algo.auto_reduce(ideal);
-        PolySet basis = algo.make_groebner_basis(reduced_ideal);
-        return algo.auto_reduce(basis);
+        auto reduced_ideal = algo.auto_reduce(ideal, statistics);
+        PolySet basis;
+        switch (algorithm) {
+            case BasisAlgorithm::BUCHBERGER: {
+                ComputationContext local_context;
+                if (!context)
+                    context = &local_context;
+                if (statistics)
+                    context->set_statistics(statistics);
+                basis = algo.make_groebner_basis(reduced_ideal, strategy, context);
+                break;
+            }
+            case BasisAlgorithm::F4:
+                basis = F4Alg<CoefficientType, Order>::make_groebner_basis(reduced_ideal, strategy, threads_count);
+                break;
+            case BasisAlgorithm::SIGNATURE: {
+                SignatureStatistics signature_statistics;
+                basis = SignatureAlg<CoefficientType, Order>::make_groebner_basis(reduced_ideal, &signature_statistics);
+                if (BuchbergerStatistics::active(statistics)) {
+                    statistics->signature_criteria += signature_statistics.avoided_reductions();
+                    statistics->zero_reductions += signature_statistics.zero_reductions;
+                }
+                break;
+            }
+            case BasisAlgorithm::PARALLEL:
+                basis = ParallelPolyAlg<CoefficientType, Order>::make_groebner_basis(reduced_ideal, strategy, threads_count);
+                break;
+            case BasisAlgorithm::HOMOGENIZED:
+                basis = HomogenizedPolyAlg<CoefficientType, Order>::make_groebner_basis(reduced_ideal, threads_count);
+                break;
+        }
+        return algo.auto_reduce(basis, statistics);
     }
 
     template <typename CoefficientType, typename Order>
@@ -0,0 +1,141 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+namespace SALIB {
+    // Every worker owns a deque: it pops its own tasks from the back and steals from the front of others
+    class ThreadPool {
+    public:
+        using Task = std::function<void()>;
+
+        inline explicit ThreadPool(size_t threads_count = std::thread::hardware_concurrency());
+        inline ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        inline void submit(Task task);
+
+        // Blocks until every submitted task is finished
+        inline void wait();
+
+        inline size_t size() const;
+
+    private:
+        struct Worker {
+            std::deque<Task> tasks;
+            std::mutex mutex;
+        };
+
+        inline void run(size_t worker_index);
+        inline bool try_pop(size_t worker_index, Task& task);
+        inline bool try_steal(size_t worker_index, Task& task);
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        std::vector<std::thread> threads;
+        std::mutex state_mutex;
+        std::condition_variable has_tasks;
+        std::condition_variable all_done;
+        std::atomic<size_t> queued{0};
+        size_t unfinished = 0;
+        size_t next_worker = 0;
+        bool stopping = false;
+    };
+
+/*
+=================================IMPLEMENTATION=================================
+*/
+
+    ThreadPool::ThreadPool(size_t threads_count) {
+        if (threads_count == 0)
+            threads_count = 1;
+        for (size_t idx = 0; idx < threads_count; ++idx)
+            workers.emplace_back(new Worker());
+        for (size_t idx = 0; idx < threads_count; ++idx)
+            threads.emplace_back(&ThreadPool::run, this, idx);
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> guard(state_mutex);
+            stopping = true;
+        }
+        has_tasks.notify_all();
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    void ThreadPool::submit(Task task) {
+        {
+            // queued is counted before the task is visible, so a worker that pops it never decrements below zero.
+            // Waiting workers check queued under state_mutex and find the task pushed
+            std::lock_guard<std::mutex> guard(state_mutex);
+            ++unfinished;
+            ++queued;
+            Worker& worker = *workers[next_worker];
+            next_worker = (next_worker + 1) % workers.size();
+            std::lock_guard<std::mutex> worker_guard(worker.mutex);
+            worker.tasks.push_back(std::move(task));
+        }
+        has_tasks.notify_one();
+    }
+
+    void ThreadPool::wait() {
+        std::unique_lock<std::mutex> lock(state_mutex);
+        all_done.wait(lock, [this] { return unfinished == 0; });
+    }
+
+    size_t ThreadPool::size() const {
+        return workers.size();
+    }
+
+    bool ThreadPool::try_pop(size_t worker_index, Task& task) {
+        Worker& worker = *workers[worker_index];
+        std::lock_guard<std::mutex> guard(worker.mutex);
+        if (worker.tasks.empty())
+            return false;
+        task = std::move(worker.tasks.back());
+        worker.tasks.pop_back();
+        --queued;
+        return true;
+    }
+
+    bool ThreadPool::try_steal(size_t worker_index, Task& task) {
+        for (size_t shift = 1; shift < workers.size(); ++shift) {
+            Worker& victim = *workers[(worker_index + shift) % workers.size()];
+            std::lock_guard<std::mutex> guard(victim.mutex);
+            if (victim.tasks.empty())
+                continue;
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            --queued;
+            return true;
+        }
+        return false;
+    }
+
+    void ThreadPool::run(size_t worker_index) {
+        while (true) {
+            Task task;
+            if (try_pop(worker_index, task) || try_steal(worker_index, task)) {
+                task();
+                std::lock_guard<std::mutex> guard(state_mutex);
+                if (--unfinished == 0)
+                    all_done.notify_all();
+                continue;
+            }
+            // queued drops together with the pop, so it counts only tasks still in a deque and an idle worker
+            // sleeps instead of waking up again for a task that is already running
+            std::unique_lock<std::mutex> lock(state_mutex);
+            has_tasks.wait(lock, [this] { return stopping || queued > 0; });
+            if (stopping && queued == 0)
+                return;
+        }
+    }
+}
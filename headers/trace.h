@@ -0,0 +1,251 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace SALIB {
+    // Times are in nanoseconds since the first use of the tracer
+    struct TraceEvent {
+        const char* name;
+        uint64_t start;
+        uint64_t duration;
+    };
+
+    // Ring of the last events of one thread, only its thread records into it
+    class TraceBuffer {
+    public:
+        inline TraceBuffer(size_t capacity, size_t thread_index);
+
+        inline void record(const char* name, uint64_t start, uint64_t duration);
+        // Oldest first. Consistent only while the owning thread records nothing
+        inline std::vector<TraceEvent> get_events() const;
+        inline void clear();
+
+        inline size_t get_thread_index() const;
+        inline const std::string& get_name() const;
+        inline void set_name(const std::string& new_name);
+
+    private:
+        std::vector<TraceEvent> events;
+        std::atomic<size_t> written{0};
+        size_t thread_index;
+        std::string name;
+    };
+
+    // Collects TraceSpan events of all threads in builds with SALIB_TRACING, otherwise spans are empty objects.
+    // Exported traces open in chrome://tracing and ui.perfetto.dev
+    class Tracer {
+    public:
+        static const size_t DEFAULT_EVENTS_PER_THREAD = 1 << 18;
+
+        inline static constexpr bool is_enabled();
+
+        // Clears earlier events. A thread gets its buffer with its first span, later spans overwrite the oldest
+        inline static void start(size_t events_per_thread = DEFAULT_EVENTS_PER_THREAD);
+        inline static void stop();
+        inline static bool is_recording();
+
+        // Shown as the name of the current thread in the trace
+        inline static void set_thread_name(const std::string& name);
+
+        inline static uint64_t now();
+        inline static void record(const char* name, uint64_t start, uint64_t end);
+
+        // Chrome trace event JSON with a complete event per span, to be called after the traced threads finished
+        inline static void write_chrome_trace(std::ostream& out);
+
+    private:
+        struct State {
+            std::atomic<bool> recording{false};
+            std::atomic<size_t> events_per_thread{DEFAULT_EVENTS_PER_THREAD};
+            std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+            std::mutex mutex;
+            std::vector<std::unique_ptr<TraceBuffer>> buffers;
+        };
+
+        inline static State& get_state();
+        inline static TraceBuffer& get_thread_buffer();
+        inline static void write_string(std::ostream& out, const std::string& text);
+        inline static void write_microseconds(std::ostream& out, uint64_t nanoseconds);
+    };
+
+    // Records its scope as an event named name, which must be a string literal. Nested spans of a thread
+    // show up as a stack
+    class TraceSpan {
+    public:
+        inline explicit TraceSpan(const char* name);
+        inline ~TraceSpan();
+
+        TraceSpan(const TraceSpan&) = delete;
+        TraceSpan& operator=(const TraceSpan&) = delete;
+
+#ifdef SALIB_TRACING
+    private:
+        const char* name;
+        uint64_t start;
+        bool active;
+#endif
+    };
+
+/*
+=================================IMPLEMENTATION=================================
+*/
+
+    TraceBuffer::TraceBuffer(size_t capacity, size_t thread_index)
+            : events(capacity == 0 ? 1 : capacity), thread_index(thread_index) {}
+
+    void TraceBuffer::record(const char* event_name, uint64_t start, uint64_t duration) {
+        size_t position = written.load(std::memory_order_relaxed);
+        events[position % events.size()] = TraceEvent{event_name, start, duration};
+        written.store(position + 1, std::memory_order_release);
+    }
+
+    std::vector<TraceEvent> TraceBuffer::get_events() const {
+        size_t count = written.load(std::memory_order_acquire);
+        size_t first = count > events.size() ? count - events.size() : 0;
+        std::vector<TraceEvent> res;
+        res.reserve(count - first);
+        for (size_t idx = first; idx < count; ++idx)
+            res.push_back(events[idx % events.size()]);
+        return res;
+    }
+
+    void TraceBuffer::clear() {
+        written.store(0, std::memory_order_release);
+    }
+
+    size_t TraceBuffer::get_thread_index() const {
+        return thread_index;
+    }
+
+    const std::string& TraceBuffer::get_name() const {
+        return name;
+    }
+
+    void TraceBuffer::set_name(const std::string& new_name) {
+        name = new_name;
+    }
+
+    constexpr bool Tracer::is_enabled() {
+#ifdef SALIB_TRACING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    Tracer::State& Tracer::get_state() {
+        // Never destroyed, threads may end their spans after the end of main
+        static State* state = new State();
+        return *state;
+    }
+
+    TraceBuffer& Tracer::get_thread_buffer() {
+        thread_local TraceBuffer* buffer = nullptr;
+        if (!buffer) {
+            State& state = get_state();
+            std::lock_guard<std::mutex> guard(state.mutex);
+            state.buffers.emplace_back(new TraceBuffer(state.events_per_thread.load(), state.buffers.size()));
+            buffer = state.buffers.back().get();
+        }
+        return *buffer;
+    }
+
+    void Tracer::start(size_t events_per_thread) {
+        State& state = get_state();
+        {
+            std::lock_guard<std::mutex> guard(state.mutex);
+            state.events_per_thread = events_per_thread;
+            for (auto& buffer : state.buffers)
+                buffer->clear();
+        }
+        state.recording.store(is_enabled(), std::memory_order_release);
+    }
+
+    void Tracer::stop() {
+        get_state().recording.store(false, std::memory_order_release);
+    }
+
+    bool Tracer::is_recording() {
+        return is_enabled() && get_state().recording.load(std::memory_order_relaxed);
+    }
+
+    void Tracer::set_thread_name(const std::string& name) {
+        if (is_enabled())
+            get_thread_buffer().set_name(name);
+    }
+
+    uint64_t Tracer::now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - get_state().epoch).count();
+    }
+
+    void Tracer::record(const char* name, uint64_t start, uint64_t end) {
+        get_thread_buffer().record(name, start, end - start);
+    }
+
+    void Tracer::write_string(std::ostream& out, const std::string& text) {
+        out << '"';
+        for (char symbol : text) {
+            if (symbol == '"' || symbol == '\\')
+                out << '\\';
+            if (static_cast<unsigned char>(symbol) >= ' ')
+                out << symbol;
+        }
+        out << '"';
+    }
+
+    void Tracer::write_microseconds(std::ostream& out, uint64_t nanoseconds) {
+        uint64_t fraction = nanoseconds % 1000;
+        out << nanoseconds / 1000 << '.' << fraction / 100 << fraction / 10 % 10 << fraction % 10;
+    }
+
+    void Tracer::write_chrome_trace(std::ostream& out) {
+        State& state = get_state();
+        std::lock_guard<std::mutex> guard(state.mutex);
+        out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+        bool first = true;
+        for (const auto& buffer : state.buffers) {
+            size_t tid = buffer->get_thread_index() + 1;
+            if (!buffer->get_name().empty()) {
+                out << (first ? "\n" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": "
+                    << tid << ", \"args\": {\"name\": ";
+                write_string(out, buffer->get_name());
+                out << "}}";
+                first = false;
+            }
+            for (const auto& event : buffer->get_events()) {
+                out << (first ? "\n" : ",\n") << "{\"name\": ";
+                write_string(out, event.name);
+                out << ", \"ph\": \"X\", \"pid\": 1, \"tid\": " << tid << ", \"ts\": ";
+                write_microseconds(out, event.start);
+                out << ", \"dur\": ";
+                write_microseconds(out, event.duration);
+                out << "}";
+                first = false;
+            }
+        }
+        out << "\n]}\n";
+    }
+
+#ifdef SALIB_TRACING
+    TraceSpan::TraceSpan(const char* name) : name(name), start(0), active(Tracer::is_recording()) {
+        if (active)
+            start = Tracer::now();
+    }
+
+    TraceSpan::~TraceSpan() {
+        if (active)
+            Tracer::record(name, start, Tracer::now());
+    }
+#else
+    TraceSpan::TraceSpan(const char*) {}
+
+    TraceSpan::~TraceSpan() {}
+#endif
+}
@@ -5,6 +5,9 @@
 #include <thread>
 #include <future>
 #include <mutex>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
 
 #include "polynomial.h"
 #include "polynomial_set.h"
@@ -13,7 +16,9 @@
 #include "orders.h"
 #include "algorithms.h"
 #include "speed_tests.h"
+#include "maple_reader.h"
 #include "stopwatch.h"
+#include "trace.h"
 #include <boost/multiprecision/gmp.hpp>
 
 using std::cout;
@@ -134,36 +139,66 @@ void see_what_i_can() {
 
 std::mutex cout_mutex;
 
-int main() {
+// Only builds with SALIB_STATISTICS or SALIB_MEMORY_ACCOUNTING collect anything, the memory counters
+// are shared by the three orders running at once
+void print_statistics(const std::string& order, const BuchbergerStatistics& statistics) {
+    if (!BuchbergerStatistics::is_enabled() && !MemoryAccounting::is_enabled())
+        return;
+    cerr << order << " statistics: ";
+    statistics.write_json(cerr);
+    cerr << "\n";
+}
+
+int main(int argc, char** argv) {
     using CoefType = Field<>; // boost::multiprecision::mpq_rational;
-    auto lex_test = [](const PolynomialSet<CoefType>& idl) -> double {
+    PairSelectionStrategy strategy = PairSelectionStrategy::NORMAL;
+    if (argc > 1 && !parse_pair_selection_strategy(argv[1], strategy)) {
+        cerr << "Unknown pair selection strategy " << argv[1] << "\n";
+        return 1;
+    }
+    SpeedTest::BasisAlgorithm algorithm = SpeedTest::BasisAlgorithm::BUCHBERGER;
+    if (argc > 2 && !SpeedTest::parse_basis_algorithm(argv[2], algorithm)) {
+        cerr << "Unknown basis algorithm " << argv[2] << "\n";
+        return 1;
+    }
+    size_t threads_count = std::thread::hardware_concurrency();
+    if (argc > 3)
+        threads_count = std::stoul(argv[3]);
+    auto lex_test = [strategy, algorithm, threads_count](const PolynomialSet<CoefType>& idl) -> double {
         StopWatch watch;
+        Tracer::set_thread_name("Lex");
         // using CoefType = Field;
         
         using Order = MonoLexOrder;
         PolynomialSet<CoefType, Order> ideal(idl);
-        auto basis = SpeedTest::calc_basis_and_reduce(ideal);
+        BuchbergerStatistics statistics;
+        auto basis = SpeedTest::calc_basis_and_reduce(ideal, strategy, algorithm, threads_count, &statistics);
         cerr << "Lex test ended\n";
         std::lock_guard<std::mutex> guard(cout_mutex);
+        print_statistics("Lex", statistics);
         cout << "Lex order:" << watch.get_duration() << "\n";
         cout.flush();
         return watch.get_duration();
     };
-    auto deglex_test = [](const PolynomialSet<CoefType>& idl) -> double {
+    auto deglex_test = [strategy, algorithm, threads_count](const PolynomialSet<CoefType>& idl) -> double {
         StopWatch watch;
+        Tracer::set_thread_name("DegLex");
         using Order = CustomOrder<MonoGradientSemiOrder, MonoLexOrder>;
         PolynomialSet<CoefType, Order> ideal(idl);
-        auto basis = SpeedTest::calc_basis_and_reduce(ideal);
+        BuchbergerStatistics statistics;
+        auto basis = SpeedTest::calc_basis_and_reduce(ideal, strategy, algorithm, threads_count, &statistics);
         cerr << "DegLex test ended\n";
         std::lock_guard<std::mutex> guard(cout_mutex);
+        print_statistics("DegLex", statistics);
         cout << "DegLex order:" << watch.get_duration() << "\n";
         cout.flush();
         
         return watch.get_duration();
     };
 
-    auto degrevlex_test = [](const PolynomialSet<CoefType>& idl) -> double {
+    auto degrevlex_test = [strategy, algorithm, threads_count](const PolynomialSet<CoefType>& idl) -> double {
         StopWatch watch;
+        Tracer::set_thread_name("DegRevLex");
         using Order = CustomOrder<MonoGradientSemiOrder, RevOrder<MonoLexOrder>>;
         PolynomialSet<CoefType, Order> ideal(idl);
         // cerr << "IDEAL DEGREVLEX:\n";
@@ -175,9 +210,11 @@ int main() {
         //         cerr << "coeff > " << mono.second << "\n";
         //     }
         // }
-        auto basis = SpeedTest::calc_basis_and_reduce(ideal);
+        BuchbergerStatistics statistics;
+        auto basis = SpeedTest::calc_basis_and_reduce(ideal, strategy, algorithm, threads_count, &statistics);
         cerr << "DegRevLex test ended\n";
         std::lock_guard<std::mutex> guard(cout_mutex);
+        print_statistics("DegRevLex", statistics);
         cout << "DegRevLex order:" << watch.get_duration() << "\n";
         cout.flush();
         // for (const auto& poly : basis) {
@@ -190,7 +227,18 @@ int main() {
     using Poly = Polynomial<CoefType, DefaultOrder>;
     using PolySet = PolynomialSet<CoefType, DefaultOrder>;
 
-    PolySet input_ideal = SpeedTest::read_polyset<CoefType, DefaultOrder>(cin);
+    // The numeric format of read_polyset starts with a count, anything else is read as a Maple system
+    PolySet input_ideal;
+    cin >> std::ws;
+    if (std::isdigit(cin.peek())) {
+        input_ideal = SpeedTest::read_polyset<CoefType, DefaultOrder>(cin);
+    } else {
+        MapleReader<CoefType, DefaultOrder> reader(cin);
+        if (!reader.read_system(input_ideal)) {
+            cerr << "Can not read the system: " << reader.get_error() << "\n";
+            return 1;
+        }
+    }
     
     cerr << "Input ideal\n";
     for (const auto& poly : input_ideal) {
@@ -231,11 +279,27 @@ int main() {
     // deglex_res.get();
     // degrevlex_res.get();
 
+    // SALIB_TRACE=<file> writes a Chrome trace of the three runs, only builds with SALIB_TRACING record spans
+    const char* trace_file = std::getenv("SALIB_TRACE");
+    if (trace_file && !Tracer::is_enabled())
+        cerr << "SALIB_TRACE is ignored, the build has no SALIB_TRACING\n";
+    if (trace_file && Tracer::is_enabled())
+        Tracer::start();
+
     std::thread lex_res(lex_test, input_ideal);
     std::thread deglex_res(deglex_test, input_ideal);
     std::thread degrevlex_res(degrevlex_test, input_ideal);
     lex_res.join();
     deglex_res.join();
     degrevlex_res.join();
+    if (trace_file && Tracer::is_enabled()) {
+        Tracer::stop();
+        std::ofstream trace(trace_file);
+        Tracer::write_chrome_trace(trace);
+        if (!trace) {
+            cerr << "Can not write the trace to " << trace_file << "\n";
+            return 1;
+        }
+    }
     return 0;
 }
\ No newline at end of file
@@ -8,6 +8,29 @@
 #include "algebra_io.h"
 #include "tests.h"
 #include "algorithms.h"
+#include "f4.h"
+#include "signature_algorithms.h"
+#include "parallel_algorithms.h"
+#include "groebner_basis.h"
+#include "homogeneous_algorithms.h"
+#include "quotient_ring.h"
+#include "binary_io.h"
+#include "maple_reader.h"
+#include "polynomial_writer.h"
+#include "trace.h"
+#include <boost/multiprecision/gmp.hpp>
+#include "monomial_ideal.h"
+#include "modular_elimination.h"
+#include <random>
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstddef>
+#include "thread_pool.h"
+#include <atomic>
+#include "field.h"
 #include <boost/rational.hpp>
 
 using std::cout;
@@ -99,6 +122,8 @@ void monomial_tests() {
     Monomial d = Monomial::lcm(a, c);
     assert(d.is_dividable_by(a) == true);
     assert(d.is_dividable_by(c) == true);
+    assert(d.get_degree() == 14);
+    assert((d / a).get_degree() == 2);
     cerr << "Mono division tests OK!\n";
 
     // Mono divisions
@@ -211,6 +236,25 @@ void hash_tests() {
     cerr << "Polynomial hash OK!\n";
 }
 
+template <int P>
+void check_field_division() {
+    for (unsigned long long a = 0; a < P; ++a) {
+        for (unsigned long long b = 1; b < P; ++b)
+            assert(Field<P>(a) / Field<P>(b) * Field<P>(b) == Field<P>(a));
+    }
+}
+
+void field_tests() {
+    // Division used to multiply by a wrong inverse
+    assert(Field<7>(3) / Field<7>(3) == Field<7>(1));
+    assert(Field<7>(6) / Field<7>(3) == Field<7>(2));
+    assert(Field<32003>(1) / Field<32003>(2) == Field<32003>(16002));
+    check_field_division<2>();
+    check_field_division<7>();
+    check_field_division<101>();
+    cerr << "Field OK!\n";
+}
+
 
 
 void polyset_tests() {
@@ -228,10 +272,1228 @@ void polyset_tests() {
     cerr << "PolynomialSet OK!\n";
 }
 
+template <typename PolySet>
+bool is_same_polyset(const PolySet& a, const PolySet& b) {
+    if (a.size() != b.size())
+        return false;
+    for (const auto& poly : a) {
+        if (!b.contains(poly))
+            return false;
+    }
+    return true;
+}
+
+void groebner_tests() {
+    using Rat = boost::rational<long long>;
+    using GrLex = CustomOrder<MonoGradientSemiOrder, MonoLexOrder>;
+    using Poly = Polynomial<Rat, GrLex>;
+    using PolySet = PolynomialSet<Rat, GrLex>;
+    using Alg = PolyAlg<Rat, GrLex>;
+    Poly x = Monomial{1};
+    Poly y = Monomial{0, 1};
+    Poly z = Monomial{0, 0, 1};
+    Poly w = Monomial{0, 0, 0, 1};
+
+    PolySet ideal;
+    ideal.add(x * x * x - Rat(2) * x * y);
+    ideal.add(x * x * y - Rat(2) * y * y + x);
+    PolySet answer;
+    answer.add(x * x);
+    answer.add(x * y);
+    answer.add(y * y - Rat(1, 2) * x);
+
+    PolySet cyclic4;
+    cyclic4.add(x + y + z + w);
+    cyclic4.add(x * y + y * z + z * w + w * x);
+    cyclic4.add(x * y * z + y * z * w + z * w * x + w * x * y);
+    cyclic4.add(x * y * z * w - Rat(1));
+    PolySet cyclic4_answer = Alg::auto_reduce(Alg::make_groebner_basis(cyclic4, PairSelectionStrategy::FIFO));
+
+    for (auto strategy : {PairSelectionStrategy::FIFO, PairSelectionStrategy::NORMAL,
+                          PairSelectionStrategy::SUGAR, PairSelectionStrategy::DEGREE_SUGAR}) {
+        assert(is_same_polyset(Alg::auto_reduce(Alg::make_groebner_basis(ideal, strategy)), answer));
+        assert(is_same_polyset(Alg::auto_reduce(Alg::make_groebner_basis(cyclic4, strategy)), cyclic4_answer));
+    }
+    // Lazy tail reduction reduces the tails only once after the last pair, the basis ends up tail reduced
+    {
+        ComputationContext context;
+        context.set_lazy_tail_reduction(true);
+        std::vector<Poly> lazy(cyclic4.begin(), cyclic4.end());
+        Alg::make_groebner_basis(lazy, PairSelectionStrategy::NORMAL, &context);
+        PolySet lazy_set;
+        for (const auto& poly : lazy) {
+            for (const auto& other : lazy) {
+                for (const auto& term : poly) {
+                    if (term.first != poly.get_largest_monomial())
+                        assert(!term.first.is_dividable_by(other.get_largest_monomial()));
+                }
+            }
+            lazy_set.add(poly);
+        }
+        assert(is_same_polyset(Alg::auto_reduce(lazy_set), cyclic4_answer));
+    }
+    // Top reduction stops as soon as the leading term is irreducible
+    std::vector<Poly> divisors = {x * x, y * y};
+    Poly f = x * x * y + x * y + y * y;
+    assert(Alg::reduce_by(f, divisors, nullptr, ReductionMode::TOP) == x * y + y * y);
+    assert(Alg::reduce_by(f, divisors) == x * y);
+    std::vector<Poly> top_reduced = {x * x + x * y, y};
+    Alg::tail_reduce(top_reduced);
+    assert(top_reduced[0] == x * x && top_reduced[1] == y);
+
+    // Generators that are not a Groebner basis keep generating the same ideal
+    std::vector<Poly> generators = {x * x * y - z, x * y * y + y, x * y + x * z, x * y - y * z + Rat(3)};
+    Alg::interreduce(generators);
+    for (size_t i = 0; i < generators.size(); ++i) {
+        assert(generators[i][generators[i].get_largest_monomial()] == Rat(1));
+        for (size_t j = 0; j < generators.size(); ++j) {
+            if (i == j)
+                continue;
+            for (const auto& term : generators[i])
+                assert(!term.first.is_dividable_by(generators[j].get_largest_monomial()));
+        }
+    }
+    PolySet generators_set;
+    for (const auto& poly : {x * x * y - z, x * y * y + y, x * y + x * z, x * y - y * z + Rat(3)})
+        generators_set.add(poly);
+    PolySet interreduced_set;
+    for (const auto& poly : generators)
+        interreduced_set.add(poly);
+    assert(is_same_polyset(Alg::auto_reduce(Alg::make_groebner_basis(generators_set)),
+                           Alg::auto_reduce(Alg::make_groebner_basis(interreduced_set))));
+
+    PairSelectionStrategy parsed;
+    assert(parse_pair_selection_strategy("degree_sugar", parsed));
+    assert(parsed == PairSelectionStrategy::DEGREE_SUGAR);
+    assert(!parse_pair_selection_strategy("random", parsed));
+    cerr << "Pair selection strategies OK!\n";
+}
+
+template <typename CoefficientType, typename Order>
+PolynomialSet<CoefficientType, Order> make_cyclic_ideal(int n) {
+    using Poly = Polynomial<CoefficientType, Order>;
+    PolynomialSet<CoefficientType, Order> ideal;
+    for (int k = 1; k < n; ++k) {
+        Poly sum;
+        for (int start = 0; start < n; ++start) {
+            Monomial mono;
+            for (int idx = 0; idx < k; ++idx)
+                mono *= Monomial((start + idx) % n);
+            sum += Poly(mono);
+        }
+        ideal.add(sum);
+    }
+    Monomial all;
+    for (int idx = 0; idx < n; ++idx)
+        all *= Monomial(idx);
+    ideal.add(Poly(all) - Poly(CoefficientType(1)));
+    return ideal;
+}
+
+// x_i = sum_j x_|j| x_|i - j| for i < n - 1 and x_0 + 2 (x_1 + ... + x_{n - 1}) = 1, with x_j = 0 for j >= n
+template <typename CoefficientType, typename Order>
+PolynomialSet<CoefficientType, Order> make_katsura_ideal(int n) {
+    using Poly = Polynomial<CoefficientType, Order>;
+    auto variable = [n](int idx) {
+        idx = std::abs(idx);
+        return idx < n ? Poly(Monomial(idx)) : Poly();
+    };
+    PolynomialSet<CoefficientType, Order> ideal;
+    for (int i = 0; i + 1 < n; ++i) {
+        Poly sum;
+        for (int j = 1 - n; j < n; ++j)
+            sum += variable(j) * variable(i - j);
+        ideal.add(sum - variable(i));
+    }
+    Poly linear = variable(0) - Poly(CoefficientType(1));
+    for (int idx = 1; idx < n; ++idx)
+        linear += Poly(CoefficientType(2)) * variable(idx);
+    ideal.add(linear);
+    return ideal;
+}
+
+// Affine system whose signature basis was wrong while signatures were weighted by the total degree of generators
+template <typename CoefficientType, typename Order>
+PolynomialSet<CoefficientType, Order> make_affine_ideal() {
+    using Coef = CoefficientType;
+    using Poly = Polynomial<Coef, Order>;
+    Poly a = Monomial{1};
+    Poly b = Monomial{0, 1};
+    Poly c = Monomial{0, 0, 1};
+    PolynomialSet<Coef, Order> ideal;
+    ideal.add(Coef(2) * c * c + Coef(7) * a);
+    ideal.add(Coef(5) * a * a * b + Poly(Coef(1)));
+    ideal.add(a * b * c + Coef(3) * c * c + Coef(4) * b + Coef(3) * c);
+    return ideal;
+}
+
+// Reduced bases of F4, the signature engine and the parallel engine agree with PolyAlg
+template <typename CoefficientType, typename Order>
+void check_engines_on(const PolynomialSet<CoefficientType, Order>& ideal) {
+    using PolySet = PolynomialSet<CoefficientType, Order>;
+    using Alg = PolyAlg<CoefficientType, Order>;
+    using F4 = F4Alg<CoefficientType, Order>;
+    using SigAlg = SignatureAlg<CoefficientType, Order>;
+    using ParAlg = ParallelPolyAlg<CoefficientType, Order>;
+    auto answer = Alg::auto_reduce(Alg::make_groebner_basis(ideal));
+    auto agrees = [&answer](const PolySet& basis) {
+        return is_same_polyset(Alg::auto_reduce(basis), answer);
+    };
+
+    assert(agrees(F4::make_groebner_basis(ideal)));
+    assert(agrees(F4::make_groebner_basis(ideal, PairSelectionStrategy::SUGAR)));
+    // Prime field matrices are eliminated on the given threads
+    assert(agrees(F4::make_groebner_basis(ideal, PairSelectionStrategy::DEGREE_SUGAR, 3)));
+
+    SignatureStatistics statistics;
+    assert(agrees(SigAlg::make_groebner_basis(ideal, &statistics)));
+    assert(statistics.zero_reductions <= statistics.pairs_considered);
+
+    for (size_t threads_count : {1, 2, 4}) {
+        assert(agrees(ParAlg::make_groebner_basis(ideal, PairSelectionStrategy::NORMAL, threads_count)));
+        assert(agrees(ParAlg::make_groebner_basis(ideal, PairSelectionStrategy::SUGAR, threads_count)));
+    }
+}
+
+template <typename CoefficientType, typename Order>
+void check_engines_on_all_inputs() {
+    using Poly = Polynomial<CoefficientType, Order>;
+    check_engines_on(make_cyclic_ideal<CoefficientType, Order>(4));
+    check_engines_on(make_katsura_ideal<CoefficientType, Order>(3));
+    check_engines_on(make_affine_ideal<CoefficientType, Order>());
+    Poly x = Monomial{1};
+    Poly y = Monomial{0, 1};
+    PolynomialSet<CoefficientType, Order> ideal;
+    ideal.add(x * x * x - CoefficientType(2) * x * y);
+    ideal.add(x * x * y - CoefficientType(2) * y * y + x);
+    check_engines_on(ideal);
+}
+
+void engine_tests() {
+    using Rat = boost::rational<long long>;
+    using GrLex = CustomOrder<MonoGradientSemiOrder, MonoLexOrder>;
+    using GrRevLex = CustomOrder<MonoGradientSemiOrder, RevOrder<MonoLexOrder>>;
+    check_engines_on_all_inputs<Rat, GrLex>();
+    check_engines_on_all_inputs<Rat, GrRevLex>();
+    check_engines_on_all_inputs<Rat, MonoLexOrder>();
+    check_engines_on_all_inputs<Field<32003>, GrRevLex>();
+    check_engines_on_all_inputs<Field<32003>, MonoLexOrder>();
+    check_engines_on(make_cyclic_ideal<Field<>, GrRevLex>(5));
+    check_engines_on(make_cyclic_ideal<Field<32003>, GrRevLex>(5));
+    cerr << "Groebner engines agree OK!\n";
+}
+
+void f4_tests() {
+    using Rat = boost::rational<long long>;
+    SparseMatrix<Rat> matrix(3);
+    matrix.add_row({{0, Rat(2)}, {1, Rat(4)}});
+    matrix.add_row({{0, Rat(1)}, {2, Rat(1)}});
+    matrix.add_row({{1, Rat(2)}, {2, Rat(-1)}});
+    matrix.row_echelon_form();
+    assert(matrix.rows_count() == 2);
+    assert(matrix[0].front().first == 0 && matrix[0].front().second == Rat(1));
+    assert(matrix[1].front().first == 1 && matrix[1].front().second == Rat(1));
+    cerr << "F4 OK!\n";
+}
+
+void signature_tests() {
+    using Rat = boost::rational<long long>;
+    using GrLex = CustomOrder<MonoGradientSemiOrder, MonoLexOrder>;
+    using Poly = Polynomial<Rat, GrLex>;
+    using PolySet = PolynomialSet<Rat, GrLex>;
+    {
+        // A rewritable pair must not hide the pair of the same signature coming from its rewriter
+        using Coef = Field<32003>;
+        using FieldPoly = Polynomial<Coef, GrLex>;
+        FieldPoly a = Monomial{1};
+        FieldPoly b = Monomial{0, 1};
+        FieldPoly c = Monomial{0, 0, 1};
+        std::vector<FieldPoly> generators = {a * c + Coef(30968) * b * b, a * a + Coef(20213) * c * c,
+                                             a * a * b + Coef(5053) * a * b * b + Coef(19944) * a * b * c};
+        PolynomialSet<Coef, GrLex> homogeneous, basis;
+        for (const auto& poly : generators)
+            homogeneous.add(poly);
+        SignatureAlg<Coef, GrLex>::make_groebner_basis(generators);
+        for (const auto& poly : generators)
+            basis.add(poly);
+        using FieldAlg = PolyAlg<Coef, GrLex>;
+        assert(is_same_polyset(FieldAlg::auto_reduce(basis),
+                               FieldAlg::auto_reduce(FieldAlg::make_groebner_basis(homogeneous))));
+    }
+
+    Poly x = Monomial{1};
+    Poly y = Monomial{0, 1};
+    Poly z = Monomial{0, 0, 1};
+    PolySet ideal;
+    ideal.add(x * x - Rat(2) * x * z + z * z);
+    ideal.add(y);
+    assert((SignatureAlg<Rat, GrLex>::is_polynomial_in_radical(x - z, ideal, 3)));
+    assert(!(SignatureAlg<Rat, GrLex>::is_polynomial_in_ideal(x - z, ideal)));
+
+    // The third generator is a combination of the first two, its reduction is skipped
+    std::vector<Poly> dependent = {x * y - z, y * z - x, z * (x * y - z) + x * (y * z - x)};
+    SignatureStatistics statistics;
+    SignatureAlg<Rat, GrLex>::make_groebner_basis(dependent, &statistics);
+    assert(statistics.zero_reductions + statistics.syzygy_criterion > 0);
+    cerr << "Signature based basis OK!\n";
+}
+
+void parallel_tests() {
+    ThreadPool pool(3);
+    std::atomic<int> sum(0);
+    for (int round = 0; round < 2; ++round) {
+        for (int idx = 1; idx <= 100; ++idx)
+            pool.submit([&sum, idx] { sum += idx; });
+        pool.wait();
+        assert(sum == 5050 * (round + 1));
+    }
+    // Idle workers pick tasks up while they are submitted, the pool still drains and shuts down
+    for (int round = 0; round < 200; ++round) {
+        ThreadPool short_pool(4);
+        std::atomic<int> done(0);
+        for (int idx = 0; idx < 16; ++idx)
+            short_pool.submit([&done] { ++done; });
+        short_pool.wait();
+        assert(done == 16);
+    }
+
+    using Rat = boost::rational<long long>;
+    using GrLex = CustomOrder<MonoGradientSemiOrder, MonoLexOrder>;
+    using Poly = Polynomial<Rat, GrLex>;
+    using PolySet = PolynomialSet<Rat, GrLex>;
+    Poly x = Monomial{1};
+    Poly y = Monomial{0, 1};
+    Poly z = Monomial{0, 0, 1};
+    PolySet ideal;
+    ideal.add(x * x * x - Rat(2) * x * y);
+    ideal.add(x * x * y - Rat(2) * y * y + x);
+    std::vector<Poly> candidates = {x * x, x * y, y * y, y * y - Rat(1, 2) * x, x + z, z * x * y, Poly()};
+    std::vector<Poly> normal_forms;
+    for (size_t threads_count : {1, 3}) {
+        std::vector<bool> members = ParallelPolyAlg<Rat, GrLex>::is_in_ideal_batch(candidates, ideal, &normal_forms, threads_count);
+        assert((members == std::vector<bool>{true, true, false, true, false, true, true}));
+        assert(normal_forms[2] == Rat(1, 2) * x);
+        assert(normal_forms[4] == x + z);
+        for (size_t idx = 0; idx < candidates.size(); ++idx)
+            assert((members[idx] == PolyAlg<Rat, GrLex>::is_polynomial_in_ideal(candidates[idx], ideal)));
+    }
+    cerr << "Parallel basis OK!\n";
+}
+
+void incremental_basis_tests() {
+    using Rat = boost::rational<long long>;
+    using GrLex = CustomOrder<MonoGradientSemiOrder, MonoLexOrder>;
+    using Poly = Polynomial<Rat, GrLex>;
+    using PolySet = PolynomialSet<Rat, GrLex>;
+    using Alg = PolyAlg<Rat, GrLex>;
+
+    PolySet cyclic4 = make_cyclic_ideal<Rat, GrLex>(4);
+    PolySet answer = Alg::auto_reduce(Alg::make_groebner_basis(cyclic4));
+    GroebnerBasis<Rat, GrLex> basis;
+    for (const auto& poly : cyclic4)
+        basis.add_generator(poly);
+    assert(is_same_polyset(basis.get_reduced_basis(), answer));
+    assert(!basis.add_generator(*cyclic4.begin()));
+
+    Poly x = Monomial{1};
+    Poly y = Monomial{0, 1};
+    Poly z = Monomial{0, 0, 1};
+    PolySet extended(cyclic4);
+    extended.add(x * x - y);
+    assert(basis.add_generator(x * x - y));
+    assert(is_same_polyset(basis.get_reduced_basis(), Alg::auto_reduce(Alg::make_groebner_basis(extended))));
+    assert(basis.contains(x * x * z - y * z));
+
+    PolySet ideal;
+    ideal.add(x * x - Rat(2) * x * z + z * z);
+    GroebnerBasis<Rat, GrLex> radical_basis(ideal);
+    size_t basis_size = radical_basis.size();
+    assert(radical_basis.is_polynomial_in_radical(x - z, 3));
+    assert(!radical_basis.is_polynomial_in_radical(x, 3));
+    assert(radical_basis.size() == basis_size);
+    assert(radical_basis.is_polynomial_in_radical(x - z, 3, 0));
+    assert(!radical_basis.is_polynomial_in_radical(x, 3, 0));
+
+    // The unit ideal collapses to {1} and stops
+    PolySet unit;
+    unit.add(x * y - Poly(Rat(1)));
+    unit.add(x);
+    GroebnerBasis<Rat, GrLex> unit_basis(unit);
+    assert(unit_basis.is_unit() && unit_basis.size() == 1);
+    assert(unit_basis.contains(y * z));
+    assert(!radical_basis.is_unit());
+    std::vector<Poly> unit_polys(unit.begin(), unit.end());
+    unit_polys.push_back(z * z - y);
+    Alg::make_groebner_basis(unit_polys);
+    assert(unit_polys.size() == 1 && Alg::is_nonzero_constant(unit_polys.front()));
+
+    PolySet square;
+    square.add(x * x * x);
+    assert(Alg::is_polynomial_in_radical(x, square, 3));
+    assert(!Alg::is_polynomial_in_radical(y, square, 3));
+
+    // One basis serves several queries
+    std::vector<Poly> radical_polys(ideal.begin(), ideal.end());
+    Alg::make_groebner_basis(radical_polys);
+    assert(Alg::is_polynomial_in_radical(x - z, radical_polys, 3));
+    assert(!Alg::is_polynomial_in_radical(x, radical_polys, 3));
+    assert(Alg::is_polynomial_in_radical(x * x - Rat(2) * x * z + z * z, radical_polys, 3));
+    assert(!Alg::is_polynomial_in_radical(Poly(Rat(1)), std::vector<Poly>(), 3));
+    // x^4 is not in (x^6), only the Rabinowitsch step finds x
+    std::vector<Poly> sixth_power = {x * x * x * x * x * x};
+    assert(Alg::is_polynomial_in_radical(x, sixth_power, 3));
+    assert(!Alg::is_polynomial_in_radical(x + y, sixth_power, 3));
+    cerr << "Incremental basis OK!\n";
+}
+
+void computation_context_tests() {
+    using GrRevLex = CustomOrder<MonoGradientSemiOrder, RevOrder<MonoLexOrder>>;
+    using Alg = PolyAlg<Field<>, GrRevLex>;
+    using Poly = Polynomial<Field<>, GrRevLex>;
+    auto ideal = make_cyclic_ideal<Field<>, GrRevLex>(5);
+    auto answer = Alg::auto_reduce(Alg::make_groebner_basis(ideal));
+
+    ComputationContext complete_context;
+    size_t last_processed = 0;
+    complete_context.set_progress_callback([&last_processed](const ComputationProgress& progress) {
+        assert(progress.pairs_processed == last_processed + 1);
+        assert(progress.basis_size >= 5);
+        last_processed = progress.pairs_processed;
+    });
+    assert(is_same_polyset(Alg::auto_reduce(Alg::make_groebner_basis(ideal, PairSelectionStrategy::NORMAL,
+                                                                     &complete_context)), answer));
+    assert(complete_context.get_status() == ComputationStatus::COMPLETE);
+    assert(last_processed == complete_context.get_pairs_processed() && last_processed > 0);
+
+    ComputationContext pair_context;
+    pair_context.set_pair_limit(3);
+    std::vector<Poly> partial(ideal.begin(), ideal.end());
+    Alg::make_groebner_basis(partial, PairSelectionStrategy::NORMAL, &pair_context);
+    assert(pair_context.get_status() == ComputationStatus::PAIR_LIMIT);
+    assert(pair_context.get_pairs_processed() == 3);
+    for (const auto& poly : partial)
+        assert(Alg::reduce_by(poly, answer).is_zero());
+
+    CancellationToken token;
+    ComputationContext cancel_context;
+    cancel_context.set_cancellation_token(token);
+    cancel_context.set_progress_callback([token](const ComputationProgress& progress) mutable {
+        if (progress.pairs_processed == 2)
+            token.cancel();
+    });
+    Alg::make_groebner_basis(ideal, PairSelectionStrategy::NORMAL, &cancel_context);
+    assert(cancel_context.get_status() == ComputationStatus::CANCELLED);
+    assert(cancel_context.get_pairs_processed() == 2);
+
+    ComputationContext time_context;
+    time_context.set_time_limit(1e-9);
+    for (size_t idx = 0; idx < 1000 && !time_context.should_stop(); ++idx) {}
+    assert(time_context.get_status() == ComputationStatus::TIME_LIMIT);
+
+    // The peak never drops below a resident size seen earlier, the reset is left to the benchmarks
+    if (ComputationContext::get_resident_memory() > 0)
+        assert(ComputationContext::get_peak_resident_memory() > 0);
+    cerr << "Computation context OK!\n";
+}
+
+// Counts standard monomials of every degree up to max_degree
+std::vector<long long> count_standard_monomials(const MonomialIdeal& ideal, size_t variables_count, size_t max_degree) {
+    std::vector<long long> res(max_degree + 1, 0);
+    std::vector<Monomial> layer = {Monomial()};
+    for (size_t degree = 0; degree <= max_degree; ++degree) {
+        std::vector<Monomial> next;
+        for (const auto& mono : layer) {
+            if (!ideal.contains(mono))
+                ++res[degree];
+            // Only variables not smaller than the last used one, so every monomial is built once
+            size_t last = 0;
+            for (size_t var = 0; var < variables_count; ++var) {
+                if (mono[var] != 0)
+                    last = var;
+            }
+            for (size_t var = last; var < variables_count; ++var)
+                next.push_back(mono * Monomial(var));
+        }
+        layer = std::move(next);
+    }
+    return res;
+}
+
+void monomial_ideal_tests() {
+    MonomialIdeal powers({Monomial{2}, Monomial{0, 3}, Monomial{2, 1}});
+    assert(powers.get_minimal_generators().size() == 2);
+    assert(powers.is_zero_dimensional());
+    assert((powers.get_hilbert_numerator() == MonomialIdeal::Series{1, 0, -1, -1, 0, 1}));
+    assert(powers.get_dimension() == 0 && powers.get_degree() == 6);
+
+    MonomialIdeal lines({Monomial{1, 1}});
+    assert(!lines.is_zero_dimensional());
+    assert(lines.get_dimension() == 1 && lines.get_degree() == 2);
+
+    MonomialIdeal embedded({Monomial{2}, Monomial{1, 1}}, 3);
+    assert(embedded.get_dimension() == 2 && embedded.get_degree() == 1);
+    assert(MonomialIdeal({}, 4).get_dimension() == 4);
+    assert(MonomialIdeal({Monomial()}, 2).get_degree() == 0);
+
+    // Hilbert function from the series against brute force counting
+    std::vector<std::vector<Monomial>> samples = {
+        {Monomial{1, 2, 1}, Monomial{0, 3}, Monomial{2, 0, 2}, Monomial{1, 1, 0, 1}, Monomial{0, 0, 1, 2}},
+        {Monomial{3}, Monomial{1, 1, 1}, Monomial{0, 2, 0, 1}, Monomial{0, 0, 2, 2}, Monomial{1, 0, 0, 3}},
+        {Monomial{1, 1}, Monomial{0, 1, 1}, Monomial{0, 0, 1, 1}, Monomial{1, 0, 0, 1}}
+    };
+    for (const auto& gens : samples) {
+        const size_t variables_count = 4, max_degree = 8;
+        MonomialIdeal ideal(gens, variables_count);
+        // Series K(t) / (1 - t)^n expanded up to max_degree
+        MonomialIdeal::Series series = ideal.get_hilbert_numerator();
+        series.resize(max_degree + 1, 0);
+        for (size_t idx = 0; idx < variables_count; ++idx) {
+            for (size_t degree = 1; degree <= max_degree; ++degree)
+                series[degree] += series[degree - 1];
+        }
+        assert(series == count_standard_monomials(ideal, variables_count, max_degree));
+    }
+
+    using Rat = boost::rational<long long>;
+    using GrLex = CustomOrder<MonoGradientSemiOrder, MonoLexOrder>;
+    using Alg = PolyAlg<Rat, GrLex>;
+    auto cyclic4 = MonomialIdeal::from_leading_monomials(Alg::make_groebner_basis(make_cyclic_ideal<Rat, GrLex>(4)));
+    assert(cyclic4.get_dimension() == 1);
+    cerr << "Monomial ideal OK!\n";
+}
+
+template <int P>
+void check_modular_elimination(size_t rows, size_t columns, unsigned seed) {
+    using Matrix = SparseMatrix<Field<P>>;
+    std::mt19937 random(seed);
+    Matrix matrix(columns);
+    for (size_t idx = 0; idx < rows; ++idx) {
+        typename Matrix::Row row;
+        for (size_t col = random() % columns; col < columns; col += 1 + random() % 4)
+            row.emplace_back(col, Field<P>(random() % P));
+        row.erase(std::remove_if(row.begin(), row.end(), [](const typename Matrix::Entry& entry) {
+            return entry.second == Field<P>(0);
+        }), row.end());
+        matrix.add_row(std::move(row));
+    }
+    Matrix expected = matrix;
+    expected.row_echelon_form();
+    for (size_t threads_count : {1, 3}) {
+        Matrix echelon = matrix;
+        EliminationStatistics statistics = ModularElimination<P>::row_echelon_form(echelon, threads_count);
+        assert(statistics.rank == expected.rows_count());
+        assert(echelon.rows_count() == expected.rows_count());
+        // Pivot columns of an echelon form are unique, the pivot rows themselves are not
+        for (size_t idx = 0; idx < echelon.rows_count(); ++idx) {
+            assert(echelon[idx].front().first == expected[idx].front().first);
+            assert(echelon[idx].front().second == Field<P>(1));
+        }
+    }
+
+    std::stringstream dump;
+    matrix.write(dump);
+    Matrix loaded = Matrix::read(dump);
+    assert(loaded.rows_count() == matrix.rows_count() && loaded.columns_count() == columns);
+    for (size_t idx = 0; idx < matrix.rows_count(); ++idx)
+        assert(loaded[idx] == matrix[idx]);
+}
+
+void elimination_tests() {
+    assert(Field<32003>(5) / Field<32003>(5) == Field<32003>(1));
+    assert(Field<7>(3) * Field<7>(Field<7>::inverse(3)) == Field<7>(1));
+    check_modular_elimination<2>(60, 50, 1);
+    check_modular_elimination<32003>(60, 50, 2);
+    check_modular_elimination<32003>(30, 80, 3);
+    check_modular_elimination<7>(120, 40, 4);
+
+    cerr << "Modular elimination OK!\n";
+}
+
+void intersection_tests() {
+    using Rat = boost::rational<long long>;
+    using GrLex = CustomOrder<MonoGradientSemiOrder, MonoLexOrder>;
+    using Poly = Polynomial<Rat, GrLex>;
+    using PolySet = PolynomialSet<Rat, GrLex>;
+    using Alg = PolyAlg<Rat, GrLex>;
+    Poly x = Monomial{1};
+    Poly y = Monomial{0, 1};
+    Poly z = Monomial{0, 0, 1};
+    Poly one = Poly(Rat(1));
+    auto make_basis = [](std::initializer_list<Poly> polys) {
+        PolySet ideal;
+        for (const auto& poly : polys)
+            ideal.add(poly);
+        return Alg::auto_reduce(Alg::make_groebner_basis(ideal));
+    };
+
+    PolySet ideal1, ideal2;
+    ideal1.add(x * x - Rat(2) * x * z + z * z);
+    ideal2.add(y);
+    assert(is_same_polyset(Alg::intersect_ideals(ideal1, ideal2, 3), make_basis({y * (x - z) * (x - z)})));
+
+    // (x, y) ∩ (x, z) = (x, yz)
+    ideal1 = make_basis({x, y});
+    ideal2 = make_basis({x, z});
+    assert(is_same_polyset(Alg::intersect_ideals(ideal1, ideal2), make_basis({x, y * z})));
+
+    // The points (1, 0) and (0, 1)
+    ideal1 = make_basis({x - one, y});
+    ideal2 = make_basis({x, y - one});
+    assert(is_same_polyset(Alg::intersect_ideals(ideal1, ideal2), make_basis({x + y - one, y * y - y})));
+
+    // The t-free part of the elimination basis is not minimal before the interreduction
+    ideal1 = make_basis({x * x - y, x * y});
+    ideal2 = make_basis({y * y - x, x * z});
+    PolySet intersection = Alg::intersect_ideals(ideal1, ideal2);
+    assert(intersection.size() == 5 && is_same_polyset(intersection, Alg::auto_reduce(intersection)));
+    for (const auto& poly : intersection)
+        assert(Alg::reduce_by(poly, ideal1).is_zero() && Alg::reduce_by(poly, ideal2).is_zero());
+
+    // Seven points on a line take two levels of blocks
+    std::vector<PolySet> points;
+    Poly product = one, six_product = one;
+    for (int idx = 0; idx < 7; ++idx) {
+        points.push_back(make_basis({x - Poly(Rat(idx)), y}));
+        product *= x - Poly(Rat(idx));
+        if (idx < 6)
+            six_product = product;
+    }
+    assert(is_same_polyset(Alg::intersect_all(points), make_basis({product, y})));
+    // Six ideals used to leave an unreduced singleton block, the unit ideal is skipped
+    std::vector<PolySet> six_points(points.begin(), points.begin() + 6);
+    assert(is_same_polyset(Alg::intersect_all(six_points), make_basis({six_product, y})));
+    six_points.push_back(make_basis({x, x - one}));
+    assert(is_same_polyset(Alg::intersect_all(six_points), make_basis({six_product, y})));
+    assert((is_same_polyset(Alg::intersect_all<1>(points), make_basis({product, y}))));
+    assert((is_same_polyset(Alg::intersect_all<2>(six_points), make_basis({six_product, y}))));
+
+    std::vector<PolySet> coordinate_planes = {make_basis({x}), make_basis({y}), make_basis({z})};
+    assert(is_same_polyset(Alg::intersect_all(coordinate_planes), make_basis({x * y * z})));
+    assert(is_same_polyset(Alg::intersect_all(std::vector<PolySet>()), make_basis({one})));
+    PolySet generators;
+    generators.add(x * x - y);
+    generators.add(x * y);
+    assert(is_same_polyset(Alg::intersect_all(std::vector<PolySet>{generators}), ideal1));
+    cerr << "Ideal intersection OK!\n";
+}
+
+void homogenized_tests() {
+    using Rat = boost::rational<long long>;
+    using GrLex = CustomOrder<MonoGradientSemiOrder, MonoLexOrder>;
+    using Poly = Polynomial<Rat, GrLex>;
+    using PolySet = PolynomialSet<Rat, GrLex>;
+    using Alg = PolyAlg<Rat, GrLex>;
+    using HomAlg = HomogenizedPolyAlg<Rat, GrLex>;
+    Poly x = Monomial{1};
+    Poly y = Monomial{0, 1};
+
+    Poly f = x * x * y - x + Poly(Rat(3));
+    using HomPoly = HomAlg::HomogeneousPolynomial;
+    HomPoly homogenized = HomPoly(Monomial{0, 2, 1}) - HomPoly(Monomial{2, 1}) + HomPoly(Rat(3), Monomial{3});
+    assert(HomAlg::homogenize(f) == homogenized);
+    assert(HomAlg::dehomogenize(homogenized) == f);
+
+    PolySet cyclic4 = make_cyclic_ideal<Rat, GrLex>(4);
+    PolySet answer = Alg::auto_reduce(Alg::make_groebner_basis(cyclic4));
+    assert(is_same_polyset(HomAlg::make_groebner_basis(cyclic4), answer));
+    assert(is_same_polyset(HomAlg::make_groebner_basis(cyclic4, 2), answer));
+
+    // Lex is not graded, its basis comes from PolyAlg without a homogenized pass
+    using LexAlg = PolyAlg<Rat, MonoLexOrder>;
+    auto lex_cyclic4 = make_cyclic_ideal<Rat, MonoLexOrder>(4);
+    assert(is_same_polyset(HomogenizedPolyAlg<Rat, MonoLexOrder>::make_groebner_basis(lex_cyclic4),
+                           LexAlg::auto_reduce(LexAlg::make_groebner_basis(lex_cyclic4))));
+
+    // Batches come in nondecreasing degree, GrLex is graded and needs no completion afterwards
+    ComputationContext context;
+    Monomial::VariableDegreeType last_degree = 0;
+    size_t restarts = 0;
+    context.set_progress_callback([&last_degree, &restarts](const ComputationProgress& progress) {
+        restarts += progress.degree < last_degree;
+        last_degree = progress.degree;
+    });
+    std::vector<Poly> generators(cyclic4.begin(), cyclic4.end());
+    HomAlg::make_groebner_basis(generators, 1, &context);
+    assert(restarts == 0 && context.get_status() == ComputationStatus::COMPLETE);
+    cerr << "Homogenized basis OK!\n";
+}
+
+void degree_limit_tests() {
+    using Rat = boost::rational<long long>;
+    using GrLex = CustomOrder<MonoGradientSemiOrder, MonoLexOrder>;
+    using Poly = Polynomial<Rat, GrLex>;
+    using PolySet = PolynomialSet<Rat, GrLex>;
+    using Alg = PolyAlg<Rat, GrLex>;
+    Poly x = Monomial{1};
+    Poly y = Monomial{0, 1};
+    Poly z = Monomial{0, 0, 1};
+
+    PolySet ideal;
+    ideal.add(x * x - y * y);
+    ideal.add(x * y);
+    PolySet full = Alg::auto_reduce(Alg::make_groebner_basis(ideal));
+
+    ComputationContext truncated;
+    truncated.set_max_degree(2);
+    PolySet partial = Alg::make_groebner_basis(ideal, PairSelectionStrategy::NORMAL, &truncated);
+    assert(truncated.get_status() == ComputationStatus::COMPLETE && truncated.is_truncated());
+    assert(!Alg::reduce_by(y * y * y, partial).is_zero());
+
+    // Degree 3 already gives the whole basis, the criteria just can not prove it
+    ComputationContext enough;
+    enough.set_max_degree(3);
+    assert(is_same_polyset(Alg::auto_reduce(Alg::make_groebner_basis(ideal, PairSelectionStrategy::NORMAL, &enough)), full));
+    ComputationContext all_pairs;
+    all_pairs.set_max_degree(5);
+    Alg::make_groebner_basis(ideal, PairSelectionStrategy::NORMAL, &all_pairs);
+    assert(!all_pairs.is_truncated());
+
+    // Coprime leading monomials: nothing is discarded, the truncated basis is complete
+    PolySet coprime;
+    coprime.add(x * x + y * z);
+    coprime.add(y * y);
+    ComputationContext low;
+    low.set_max_degree(1);
+    Alg::make_groebner_basis(coprime, PairSelectionStrategy::NORMAL, &low);
+    assert(!low.is_truncated());
+
+    // Membership in a homogeneous ideal only needs the basis up to the degree of the polynomial
+    assert(Alg::is_homogeneous(x * x - y * y) && !Alg::is_homogeneous(x * x - y));
+    assert(Alg::is_polynomial_in_ideal(y * y * y, ideal));
+    assert(Alg::is_polynomial_in_ideal(x * x * x + y * y * y * z, ideal));
+    assert(!Alg::is_polynomial_in_ideal(x * x, ideal));
+    assert(!Alg::is_polynomial_in_ideal(y * y * y + x, ideal));
+    cerr << "Degree limit OK!\n";
+}
+
+void quotient_ring_tests() {
+    using GrRevLex = CustomOrder<MonoGradientSemiOrder, RevOrder<MonoLexOrder>>;
+    using Coef = Field<32003>;
+    using Poly = Polynomial<Coef, GrRevLex>;
+    using Alg = PolyAlg<Coef, GrRevLex>;
+
+    auto cyclic5 = make_cyclic_ideal<Coef, GrRevLex>(5);
+    auto basis = Alg::auto_reduce(Alg::make_groebner_basis(cyclic5));
+    std::vector<Poly> basis_polys(basis.begin(), basis.end());
+    QuotientRing<Coef, GrRevLex> ring(basis);
+    assert(ring.is_zero_dimensional());
+    assert(ring.dimension() == 70);
+    assert(ring.get_standard_monomials().front() == Monomial());
+    assert(static_cast<long long>(ring.dimension()) ==
+           MonomialIdeal::from_leading_monomials(basis_polys).get_degree());
+
+    std::mt19937 generator(7);
+    auto random_poly = [&generator](int degree) {
+        Poly poly;
+        for (int term = 0; term < 6; ++term) {
+            Monomial mono;
+            for (int step = 0; step < degree; ++step)
+                mono *= Monomial(generator() % 5);
+            poly += Poly(Coef(generator() % 32003), mono);
+        }
+        return poly;
+    };
+    for (int iteration = 0; iteration < 20; ++iteration) {
+        Poly f = random_poly(3 + iteration % 4), g = random_poly(2);
+        assert(ring.reduce(f) == Alg::reduce_by(f, basis_polys));
+        auto product = ring.multiply(ring.normal_form(f), ring.normal_form(g));
+        assert(ring.to_polynomial(product) == Alg::reduce_by(f * g, basis_polys));
+        auto shifted = ring.multiply_by_variable(ring.normal_form(f), 2);
+        assert(ring.to_polynomial(shifted) == Alg::reduce_by(f * Poly(Monomial(2)), basis_polys));
+    }
+    for (const auto& poly : basis_polys)
+        assert(ring.reduce(poly).is_zero());
+
+    // Not zero-dimensional: x * y = 0 has infinitely many standard monomials
+    std::vector<Poly> line = {Poly(Monomial{1, 1})};
+    QuotientRing<Coef, GrRevLex> empty(line);
+    assert(!empty.is_zero_dimensional() && empty.dimension() == 0);
+    cerr << "Quotient ring OK!\n";
+}
+
+void binary_io_tests() {
+    using GrLex = CustomOrder<MonoGradientSemiOrder, MonoLexOrder>;
+    using GrRevLex = CustomOrder<MonoGradientSemiOrder, RevOrder<MonoLexOrder>>;
+    using Coef = Field<32003>;
+    using Poly = Polynomial<Coef, GrRevLex>;
+    using Alg = PolyAlg<Coef, GrRevLex>;
+
+    auto basis = Alg::auto_reduce(Alg::make_groebner_basis(make_cyclic_ideal<Coef, GrRevLex>(5)));
+    std::vector<Poly> polys(basis.begin(), basis.end());
+    std::ostringstream out;
+    write_binary(out, basis);
+    std::string bytes = out.str();
+    // A copy keeps the blocks 8-byte aligned, as a mapped file is
+    std::vector<uint64_t> aligned((bytes.size() + 7) / 8);
+    std::memcpy(aligned.data(), bytes.data(), bytes.size());
+
+    BinaryPolySetView<Coef, GrRevLex> view;
+    assert(view.open(aligned.data(), bytes.size()));
+    assert(view.size() == polys.size() && view.get_variables_count() == 5);
+    for (size_t idx = 0; idx < polys.size(); ++idx) {
+        auto poly = view[idx];
+        assert(poly.size() == static_cast<size_t>(std::distance(polys[idx].begin(), polys[idx].end())));
+        assert(poly.get_monomial(0).to_monomial() == polys[idx].get_largest_monomial());
+        assert(poly.get_coefficient(0) == Coef(1));
+        assert(poly.to_polynomial() == polys[idx]);
+    }
+
+    // Another order, coefficient type or a truncated file are rejected
+    BinaryPolySetView<Coef, GrLex> other_order;
+    assert(!other_order.open(aligned.data(), bytes.size()));
+    BinaryPolySetView<Field<101>, GrRevLex> other_field;
+    assert(!other_field.open(aligned.data(), bytes.size()));
+    assert(!view.open(aligned.data(), bytes.size() - 1));
+
+    // Damaged headers and offsets are rejected before anything is read out of bounds
+    auto open_damaged = [&aligned, &bytes](size_t field_offset, uint64_t value) {
+        std::vector<uint64_t> damaged(aligned);
+        std::memcpy(reinterpret_cast<unsigned char*>(damaged.data()) + field_offset, &value, sizeof(value));
+        BinaryPolySetView<Coef, GrRevLex> damaged_view;
+        return damaged_view.open(damaged.data(), bytes.size());
+    };
+    size_t first_offset = sizeof(BinaryHeader);
+    assert(!open_damaged(first_offset + sizeof(uint64_t), polys.size() + 1000));
+    assert(!open_damaged(first_offset, 1000));
+    assert(!open_damaged(offsetof(BinaryHeader, polynomials_count), ~uint64_t(0)));
+    assert(!open_damaged(offsetof(BinaryHeader, terms_count), uint64_t(1) << 62));
+    assert(!open_damaged(offsetof(BinaryHeader, variables_count), uint64_t(1) << 61));
+    assert(open_damaged(first_offset, 0));
+
+    // Exponents of every width survive
+    using Lex = MonoLexOrder;
+    std::vector<Polynomial<Coef, Lex>> wide;
+    for (uint64_t degree : {200ULL, 300ULL, 70000ULL, 5000000000ULL}) {
+        Monomial mono;
+        mono.set_var_degree(1, degree);
+        wide.push_back(Polynomial<Coef, Lex>(mono) + Polynomial<Coef, Lex>(Monomial(0, 3)));
+    }
+    for (size_t count = 1; count <= wide.size(); ++count) {
+        std::vector<Polynomial<Coef, Lex>> part(wide.begin(), wide.begin() + count);
+        std::ostringstream wide_out;
+        write_binary(wide_out, part);
+        std::string wide_bytes = wide_out.str();
+        std::vector<uint64_t> wide_aligned((wide_bytes.size() + 7) / 8);
+        std::memcpy(wide_aligned.data(), wide_bytes.data(), wide_bytes.size());
+        BinaryPolySetView<Coef, Lex> wide_view;
+        assert(wide_view.open(wide_aligned.data(), wide_bytes.size()));
+        for (size_t idx = 0; idx < count; ++idx)
+            assert(wide_view[idx].to_polynomial() == part[idx]);
+    }
+
+    // Rational coefficients through a mapped file
+    using Rat = boost::rational<long long>;
+    using RatAlg = PolyAlg<Rat, GrLex>;
+    auto rational_basis = RatAlg::auto_reduce(RatAlg::make_groebner_basis(make_cyclic_ideal<Rat, GrLex>(4)));
+    std::string filename = "binary_io_test.bin";
+    {
+        std::ofstream file(filename, std::ios::binary);
+        write_binary(file, rational_basis);
+    }
+    MappedFile mapped;
+    assert(mapped.open(filename));
+    BinaryPolySetView<Rat, GrLex> rational_view;
+    assert(rational_view.open(mapped.data(), mapped.size()));
+    auto loaded = rational_view.to_polyset();
+    assert(loaded.size() == rational_basis.size());
+    for (const auto& poly : rational_basis)
+        assert(loaded.contains(poly));
+    mapped.close();
+    std::remove(filename.c_str());
+    cerr << "Binary io OK!\n";
+}
+
+void maple_reader_tests() {
+    using GrLex = CustomOrder<MonoGradientSemiOrder, MonoLexOrder>;
+    using Coef = Field<32003>;
+    using Poly = Polynomial<Coef, GrLex>;
+    const std::string text =
+        "# first\n"
+        "# two variables\n"
+        "var := [x, y]:\n"
+        "sys := [x^2 - 3*x*y + x*x, 123456789012345678901234567890*y + 1/2,\n"
+        "  -10000000000000000000000000000000000000007 * x^3*y^2 - y*x^3*y]:\n"
+        "\n"
+        "# second\n"
+        "var := [b, a]: sys := [a*b - 1, 2*b^10/4];\n";
+    MapleReader<Coef, GrLex> reader(text.data(), text.size());
+    MapleSystem<Coef, GrLex> system;
+    assert(reader.read_system(system));
+    assert(system.name == "first" && system.description == "two variables");
+    const std::vector<std::string> names = {"x", "y"};
+    assert(system.variables == names);
+    assert(system.polynomials.size() == 3);
+    Poly x(Monomial(0)), y(Monomial(1));
+    assert(system.polynomials[0] == Coef(2) * x * x - Coef(3) * x * y);
+    assert(system.polynomials[1] == Coef(13675) * y + Coef(16002));
+    assert(system.polynomials[2] == (Coef(24267) - Coef(1)) * x * x * x * y * y);
+
+    PolynomialSet<Coef, GrLex> second;
+    assert(reader.read_system(second));
+    assert(second.size() == 2 && second.contains(x * y - Coef(1)) && second.contains(Poly(Monomial(0, 10))));
+    assert(!reader.read_system(system) && !reader.has_error());
+
+    // Arbitrary precision coefficients survive, names can be mapped to fixed indices
+    using BigRat = boost::multiprecision::mpq_rational;
+    const std::string big = "var := [t, s]: sys := [s*t - 340282366920938463463374607431768211457/3]:";
+    MapleReader<BigRat, GrLex> big_reader(big.data(), big.size());
+    big_reader.set_variable_index("t", 4);
+    MapleSystem<BigRat, GrLex> big_system;
+    assert(big_reader.read_system(big_system));
+    assert(big_system.variables.size() == 5 && big_system.variables[4] == "t" && big_system.variables[1] == "s");
+    BigRat expected("340282366920938463463374607431768211457/3");
+    using BigPoly = Polynomial<BigRat, GrLex>;
+    assert(big_system.polynomials[0] == BigPoly(Monomial(1) * Monomial(4)) - BigPoly(expected));
+
+    // Errors name the line
+    const std::string broken = "var := [x]:\nsys := [x + z]:";
+    MapleReader<Coef, GrLex> broken_reader(broken.data(), broken.size());
+    assert(!broken_reader.read_system(system) && broken_reader.has_error());
+    assert(broken_reader.get_error() == "line 2: unknown variable z");
+
+    // The same systems from a mapped file and from a stream
+    std::string filename = "maple_reader_test.txt";
+    {
+        std::ofstream file(filename);
+        file << text;
+    }
+    MapleReader<Coef, GrLex> file_reader(filename);
+    assert(file_reader.read_system(system) && system.polynomials[1] == Coef(13675) * y + Coef(16002));
+    std::istringstream stream(text);
+    MapleReader<Coef, GrLex> stream_reader(stream);
+    assert(stream_reader.read_system(system) && stream_reader.read_system(system) && system.name == "second");
+    std::remove(filename.c_str());
+    cerr << "Maple reader OK!\n";
+}
+
+// Accepts characters but can not seek, like a pipe
+class AppendOnlyBuffer : public std::streambuf {
+public:
+    std::string text;
+
+protected:
+    int overflow(int symbol) override {
+        if (symbol != EOF)
+            text += static_cast<char>(symbol);
+        return symbol;
+    }
+};
+
+void polynomial_writer_tests() {
+    using GrLex = CustomOrder<MonoGradientSemiOrder, MonoLexOrder>;
+    using GrRevLex = CustomOrder<MonoGradientSemiOrder, RevOrder<MonoLexOrder>>;
+    using Coef = Field<32003>;
+    using Poly = Polynomial<Coef, GrRevLex>;
+    using Alg = PolyAlg<Coef, GrRevLex>;
+
+    // Both formats of a small polynomial
+    using Rat = boost::rational<long long>;
+    using RatPoly = Polynomial<Rat, GrLex>;
+    RatPoly x(Monomial(0)), y(Monomial(1));
+    std::vector<RatPoly> small = {x * x * y - Rat(3, 2) * y + Rat(-7), -x};
+    std::ostringstream maple, numeric;
+    {
+        PolynomialWriter writer(maple);
+        writer.set_variable_names({"x", "y"});
+        writer.write_system(small);
+        PolynomialWriter numeric_writer(numeric, PolynomialFormat::NUMERIC);
+        numeric_writer.write_system(small);
+    }
+    assert(maple.str() == "var := [x, y]:\nsys := [x^2*y-3/2*y-7,\n-x]:\n");
+    assert(numeric.str() == std::string(19, ' ') + "2\n3\n1 1 2 0 2 1 1\n-3 2 1 1 1\n-7 1 0\n1\n-1 1 1 0 1\n");
+
+    // A large basis goes through small buffers and reads back unchanged
+    auto basis = Alg::auto_reduce(Alg::make_groebner_basis(make_cyclic_ideal<Coef, GrRevLex>(5)));
+    std::vector<Poly> polys(basis.begin(), basis.end());
+    std::ostringstream out;
+    {
+        PolynomialWriter writer(out, PolynomialFormat::MAPLE, 64);
+        writer.write_system(polys, 5);
+    }
+    std::string text = out.str();
+    MapleReader<Coef, GrRevLex> reader(text.data(), text.size());
+    MapleSystem<Coef, GrRevLex> system;
+    assert(reader.read_system(system) && system.polynomials == polys);
+
+    // Elements streamed while the basis is computed, the count is patched or held back
+    auto cyclic4 = make_cyclic_ideal<Coef, GrRevLex>(4);
+    for (int seekable = 0; seekable < 2; ++seekable) {
+        std::vector<Poly> ideal(cyclic4.begin(), cyclic4.end());
+        size_t generators = ideal.size();
+        std::ostringstream seekable_out;
+        AppendOnlyBuffer pipe;
+        std::ostream pipe_out(&pipe);
+        {
+            PolynomialWriter writer(seekable ? static_cast<std::ostream&>(seekable_out) : pipe_out,
+                                    PolynomialFormat::NUMERIC, 16);
+            ComputationContext context;
+            writer.stream_elements(context, ideal);
+            writer.begin_system(4);
+            Alg::make_groebner_basis(ideal, PairSelectionStrategy::NORMAL, &context);
+            writer.end_system();
+        }
+        std::istringstream in(seekable ? seekable_out.str() : pipe.text);
+        size_t count = 0;
+        in >> count;
+        assert(count > 0 && count == ideal.size() - generators);
+    }
+    cerr << "Polynomial writer OK!\n";
+}
+
+void checkpoint_tests() {
+    using GrRevLex = CustomOrder<MonoGradientSemiOrder, RevOrder<MonoLexOrder>>;
+    using Alg = PolyAlg<Field<32003>, GrRevLex>;
+    using Poly = Polynomial<Field<32003>, GrRevLex>;
+    auto ideal = make_cyclic_ideal<Field<32003>, GrRevLex>(5);
+    std::vector<Poly> answer(ideal.begin(), ideal.end());
+    Alg::make_groebner_basis(answer, PairSelectionStrategy::SUGAR);
+
+    // Stopped after some pairs and resumed, possibly several times
+    std::string filename = "checkpoint_test.bin";
+    for (size_t limit : {1, 7, 40}) {
+        std::vector<Poly> basis(ideal.begin(), ideal.end());
+        ComputationContext context;
+        context.set_pair_limit(limit);
+        context.set_checkpoint(filename, 1e9);
+        Alg::make_groebner_basis(basis, PairSelectionStrategy::SUGAR, &context);
+        assert(context.get_status() == ComputationStatus::PAIR_LIMIT);
+        while (true) {
+            std::vector<Poly> resumed;
+            ComputationContext resume_context;
+            resume_context.set_pair_limit(limit);
+            resume_context.set_checkpoint(filename, 1e9);
+            assert(Alg::resume_groebner_basis(filename, resumed, &resume_context));
+            if (resume_context.get_status() == ComputationStatus::COMPLETE) {
+                assert(resumed == answer);
+                break;
+            }
+        }
+    }
+
+    // Periodic checkpoints of a complete run
+    std::vector<Poly> basis(ideal.begin(), ideal.end());
+    ComputationContext periodic_context;
+    periodic_context.set_checkpoint(filename, 0);
+    Alg::make_groebner_basis(basis, PairSelectionStrategy::SUGAR, &periodic_context);
+    assert(basis == answer);
+    std::vector<Poly> resumed;
+    assert(Alg::resume_groebner_basis(filename, resumed));
+    assert(resumed == answer);
+
+    // Other types and missing files are rejected
+    using GrLex = CustomOrder<MonoGradientSemiOrder, MonoLexOrder>;
+    using OtherOrderAlg = PolyAlg<Field<32003>, GrLex>;
+    using OtherFieldAlg = PolyAlg<Field<101>, GrRevLex>;
+    std::vector<OtherOrderAlg::PolynomialType> other_order;
+    assert(!OtherOrderAlg::resume_groebner_basis(filename, other_order));
+    std::vector<OtherFieldAlg::PolynomialType> other_field;
+    assert(!OtherFieldAlg::resume_groebner_basis(filename, other_field));
+    std::remove(filename.c_str());
+    assert(!Alg::resume_groebner_basis(filename, resumed));
+
+    // A failed save is counted by the context, the computation goes on
+    std::vector<Poly> unsaved(ideal.begin(), ideal.end());
+    ComputationContext unwritable_context;
+    unwritable_context.set_checkpoint("missing_directory/checkpoint_test.bin", 0);
+    Alg::make_groebner_basis(unsaved, PairSelectionStrategy::SUGAR, &unwritable_context);
+    assert(unsaved == answer && unwritable_context.get_failed_checkpoints() > 0);
+    assert(periodic_context.get_failed_checkpoints() == 0);
+
+    // Coefficients without a binary encoding are computed as before, every checkpoint fails
+    using BigRat = boost::multiprecision::mpq_rational;
+    using BigRatAlg = PolyAlg<BigRat, GrRevLex>;
+    using RatAlg = PolyAlg<boost::rational<long long>, GrRevLex>;
+    static_assert(!GroebnerCheckpoint<BigRat, GrRevLex>::is_supported(), "mpq_rational has no binary encoding");
+    auto big_ideal = make_cyclic_ideal<BigRat, GrRevLex>(4);
+    auto rat_basis = RatAlg::make_groebner_basis(make_cyclic_ideal<boost::rational<long long>, GrRevLex>(4));
+    std::vector<BigRatAlg::PolynomialType> big_basis(big_ideal.begin(), big_ideal.end());
+    ComputationContext big_context;
+    big_context.set_checkpoint(filename, 0);
+    BigRatAlg::make_groebner_basis(big_basis, PairSelectionStrategy::NORMAL, &big_context);
+    assert(big_context.get_status() == ComputationStatus::COMPLETE && big_context.get_failed_checkpoints() > 0);
+    assert(big_basis.size() == rat_basis.size());
+    for (const auto& poly : big_ideal)
+        assert(BigRatAlg::reduce_by(poly, big_basis).is_zero());
+    std::vector<BigRatAlg::PolynomialType> big_resumed;
+    assert(!BigRatAlg::resume_groebner_basis(filename, big_resumed));
+    std::ifstream missing(filename);
+    assert(!missing);
+    cerr << "Checkpoint OK!\n";
+}
+
+void buchberger_statistics_tests() {
+    using GrRevLex = CustomOrder<MonoGradientSemiOrder, RevOrder<MonoLexOrder>>;
+    using Alg = PolyAlg<Field<32003>, GrRevLex>;
+    using Poly = Polynomial<Field<32003>, GrRevLex>;
+    auto ideal = make_cyclic_ideal<Field<32003>, GrRevLex>(5);
+    std::vector<Poly> answer(ideal.begin(), ideal.end());
+    Alg::make_groebner_basis(answer);
+
+    BuchbergerStatistics statistics;
+    ComputationContext context;
+    context.set_statistics(&statistics);
+    std::vector<Poly> basis(ideal.begin(), ideal.end());
+    Alg::make_groebner_basis(basis, PairSelectionStrategy::NORMAL, &context);
+    assert(basis == answer);
+    Alg::auto_reduce(Alg::PolySet(ideal), &statistics);
+    std::ostringstream json;
+    statistics.write_json(json);
+
+    if (!BuchbergerStatistics::is_enabled()) {
+        assert(context.get_statistics() == nullptr);
+        assert(statistics.pairs_generated == 0 && statistics.reduction_steps == 0);
+        assert(json.str().find("\"enabled\": false") != std::string::npos);
+        cerr << "Buchberger statistics OK (disabled)!\n";
+        return;
+    }
+    // Every pair of elements is generated once and ends in exactly one place
+    size_t elements = statistics.peak_basis_size;
+    assert(elements >= basis.size());
+    assert(statistics.pairs_generated == elements * (elements - 1) / 2);
+    assert(statistics.product_criterion + statistics.chain_criterion + statistics.s_polynomials ==
+           statistics.pairs_generated);
+    assert(statistics.s_polynomials == statistics.zero_reductions + elements - ideal.size());
+    assert(statistics.reduction_steps > 0 && statistics.max_polynomial_length > 0);
+    assert(statistics.top_reduction_seconds > 0 && statistics.interreduction_seconds > 0);
+    std::string expected = "\"s_polynomials\": " + std::to_string(statistics.s_polynomials) + ",";
+    assert(json.str().find(expected) != std::string::npos);
+    cerr << "Buchberger statistics OK!\n";
+}
+
+void memory_accounting_tests() {
+    using GrRevLex = CustomOrder<MonoGradientSemiOrder, RevOrder<MonoLexOrder>>;
+    using Alg = PolyAlg<Field<32003>, GrRevLex>;
+    using Poly = Polynomial<Field<32003>, GrRevLex>;
+    using NodeAllocator = AccountedAllocator<int, MemoryCategory::POLYNOMIAL_NODES>;
+    auto ideal = make_cyclic_ideal<Field<32003>, GrRevLex>(5);
+
+    MemoryAccounting::reset();
+    size_t before = MemoryAccounting::get_current_bytes();
+    {
+        std::vector<Poly> basis(ideal.begin(), ideal.end());
+        Alg::make_groebner_basis(basis);
+        Alg::interreduce(basis);
+        if (!MemoryAccounting::is_enabled()) {
+            assert((std::is_same<NodeAllocator, std::allocator<int>>::value));
+            assert(MemoryAccounting::get_peak_bytes() == 0);
+            assert(MemoryAccounting::get_usage(MemoryCategory::POLYNOMIAL_NODES).allocations == 0);
+            cerr << "Memory accounting OK (disabled)!\n";
+            return;
+        }
+        assert(MemoryAccounting::get_current_bytes() > before);
+        for (auto category : {MemoryCategory::POLYNOMIAL_NODES, MemoryCategory::MONOMIAL_VECTORS,
+                              MemoryCategory::PAIR_QUEUE}) {
+            CategoryMemoryUsage usage = MemoryAccounting::get_usage(category);
+            assert(usage.allocations > 0 && usage.peak_bytes >= usage.current_bytes);
+        }
+        for (auto phase : {MemoryPhase::PAIR_PROCESSING, MemoryPhase::REDUCTION, MemoryPhase::INTERREDUCTION})
+            assert(MemoryAccounting::get_usage(phase).allocations > 0);
+        assert(MemoryAccounting::get_usage(MemoryPhase::REDUCTION).peak_bytes <= MemoryAccounting::get_peak_bytes());
+    }
+    // Everything the computation allocated is freed with the basis
+    assert(MemoryAccounting::get_current_bytes() == before);
+    assert(MemoryAccounting::get_usage(MemoryCategory::PAIR_QUEUE).current_bytes == 0);
+    std::ostringstream json;
+    MemoryAccounting::write_json(json);
+    assert(json.str().find("\"pair_queue\": {\"allocations\": ") != std::string::npos);
+    cerr << "Memory accounting OK!\n";
+}
+
+void trace_tests() {
+    using GrRevLex = CustomOrder<MonoGradientSemiOrder, RevOrder<MonoLexOrder>>;
+    using Alg = PolyAlg<Field<32003>, GrRevLex>;
+    auto ideal = make_cyclic_ideal<Field<32003>, GrRevLex>(4);
+
+    // Nothing is recorded before start
+    Alg::auto_reduce(ideal);
+    Tracer::start();
+    Alg::auto_reduce(Alg::make_groebner_basis(ideal));
+    {
+        TraceSpan outer("outer");
+        TraceSpan inner("inner");
+    }
+    // A thread fills only its own ring, the oldest spans are overwritten
+    Tracer::start(8);
+    std::thread worker([]() {
+        Tracer::set_thread_name("worker \"1\"");
+        for (size_t idx = 0; idx < 20; ++idx)
+            TraceSpan span(idx < 12 ? "old" : "new");
+    });
+    worker.join();
+    Tracer::stop();
+    {
+        TraceSpan ignored("stopped");
+    }
+    std::ostringstream trace;
+    Tracer::write_chrome_trace(trace);
+    std::string json = trace.str();
+    assert(json.find("{\"displayTimeUnit\": \"ms\", \"traceEvents\": [") == 0);
+    assert(json.find("\"stopped\"") == std::string::npos);
+    assert(json.find("\"old\"") == std::string::npos);
+    if (!Tracer::is_enabled()) {
+        assert(!Tracer::is_recording());
+        assert(json.find("\"ph\"") == std::string::npos);
+        cerr << "Trace OK (disabled)!\n";
+        return;
+    }
+    size_t spans = 0;
+    for (size_t pos = json.find("\"name\": \"new\""); pos != std::string::npos;
+         pos = json.find("\"name\": \"new\"", pos + 1))
+        ++spans;
+    assert(spans == 8);
+    assert(json.find("\"args\": {\"name\": \"worker \\\"1\\\"\"}") != std::string::npos);
+
+    // The second start cleared the spans of this thread, record them again and check the nesting
+    Tracer::start();
+    {
+        TraceSpan outer("outer");
+        Alg::make_groebner_basis(ideal);
+    }
+    Tracer::stop();
+    trace.str("");
+    Tracer::write_chrome_trace(trace);
+    json = trace.str();
+    for (const char* name : {"\"make_groebner_basis\"", "\"reduce_by\"", "\"s_polynomial\"", "\"outer\""})
+        assert(json.find(name) != std::string::npos);
+    assert(json.find("\"auto_reduce\"") == std::string::npos);
+    // Events of a thread are stored as they end, so the outer span follows everything it contains
+    size_t outer = json.find("\"outer\"");
+    size_t start = json.find("\"ts\": ", outer) + 6;
+    size_t duration = json.find("\"dur\": ", outer) + 7;
+    double outer_start = std::stod(json.substr(start));
+    double outer_end = outer_start + std::stod(json.substr(duration));
+    start = json.find("\"ts\": ", json.find("\"make_groebner_basis\"")) + 6;
+    assert(json.find("\"make_groebner_basis\"") < outer);
+    double inner_start = std::stod(json.substr(start));
+    assert(outer_start <= inner_start && inner_start <= outer_end);
+    cerr << "Trace OK!\n";
+}
+
 void test_all() {
     
     monomial_tests();
     polynomial_tests();
     hash_tests();
+    field_tests();
     polyset_tests();
+    groebner_tests();
+    f4_tests();
+    engine_tests();
+    signature_tests();
+    parallel_tests();
+    incremental_basis_tests();
+    computation_context_tests();
+    monomial_ideal_tests();
+    elimination_tests();
+    intersection_tests();
+    homogenized_tests();
+    degree_limit_tests();
+    quotient_ring_tests();
+    binary_io_tests();
+    maple_reader_tests();
+    polynomial_writer_tests();
+    checkpoint_tests();
+    buchberger_statistics_tests();
+    memory_accounting_tests();
+    trace_tests();
 }
@@ -2,7 +2,6 @@ import argparse
 import re
 from collections import namedtuple
 import subprocess
-from io import StringIO
 import logging
 from typing import List
 from multiprocessing import Pool
@@ -15,32 +14,11 @@ TESTS_RE = re.compile(
     re.MULTILINE,
 )
 
-SYSTEM_RE = re.compile(
-    r",",
-    re.MULTILINE,
-)
-
-POLY_RE = re.compile(
-    r"(\+|\-)",
-    re.MULTILINE,
-)
-
-MONOMIAL_RE = re.compile(
-    r"\*",
-    re.MULTILINE,
-)
-
-VARIABLE_RE = re.compile(
-    r"x(?P<idx>\d+)(\^(?P<degree>\d+)|)",
-    re.MULTILINE,
-)
-
 TEST_RESULT_RE = re.compile(
     r"^(?P<test_name>[^:]*):(?P<test_time>[^:]*)$",
     re.MULTILINE,
 )
 
-Monomial = namedtuple("Monomial", ("num", "denom", "vars"))
 Test = namedtuple("Test", ("name", "description", "results"))
 
 logger = logging.getLogger("TestLauncher")
@@ -54,54 +32,6 @@ fh.setFormatter(formatter)
 logger.addHandler(fh)
 
 
-def read_system(system: str):
-    polys = SYSTEM_RE.split(system)
-    res = []
-    for poly in polys:
-        poly_res = []
-        next_sign = 1
-        for monomial in POLY_RE.split(poly):
-            if not monomial.strip():
-                continue
-            if monomial == "-":
-                next_sign = -1
-                continue
-            if monomial == "+":
-                next_sign = 1
-                continue
-            num = 1
-            vars_list = []
-            for elem in MONOMIAL_RE.split(monomial):
-                find_var = VARIABLE_RE.search(elem)
-                if find_var:
-                    idx = find_var.group("idx")
-                    degree = find_var.group("degree") or 1
-                    vars_list.append((idx, degree))
-                else:
-                    num = int(elem.strip())
-            num *= next_sign
-            poly_res.append(Monomial(num, 1, vars_list))
-        res.append(poly_res)
-    return res
-
-
-def system_to_input_format(sys):
-    output = StringIO()
-
-    print(len(sys), file=output)
-    for poly in sys:
-        print(len(poly), file=output)
-        for mono in poly:
-            print(mono.num, mono.denom, file=output)
-            print(len(mono.vars), file=output)
-            for var in mono.vars:
-                print(var[0], var[1], file=output)
-
-    res = output.getvalue()
-    output.close()
-    return res
-
-
 def iterate_through_matrix(matrix):
     for row_idx, row in enumerate(matrix):
         for col_idx, elem in enumerate(row):
@@ -130,12 +60,12 @@ def render_tests(tests: List[Test]):
     return "\n".join([close_line] + rendered_lines + [close_line])
 
 
-def run_test(name, description, variables, ideal, exec_filename, timeout):
+def run_test(name, description, variables, ideal, exec_filename, timeout, exec_args):
     descr = description
-    sys = read_system(ideal)
-    input_for_program = system_to_input_format(sys)
+    # The program reads the system itself, so coefficients keep their full precision
+    input_for_program = "var := [{}]:\nsys := [{}]:\n".format(variables, ideal)
     process = subprocess.Popen(
-        [exec_filename],
+        [exec_filename] + exec_args,
         stdin=subprocess.PIPE,
         stdout=subprocess.PIPE,
         stderr=subprocess.PIPE
@@ -162,7 +92,12 @@ def run_test_wrapper(test):
     return run_test(*test)
 
 
-def main(exec_filename, test_filename, timeout, processes):
+def main(exec_filename, test_filename, timeout, processes, strategy, algorithm, threads):
+    exec_args = [strategy] if strategy else []
+    if algorithm or threads:
+        exec_args = [strategy or "normal", algorithm or "buchberger"]
+    if threads:
+        exec_args.append(str(threads))
     with open(test_filename, "r") as f:
         text = f.read()
     parsed_tests_configs = []
@@ -171,7 +106,7 @@ def main(exec_filename, test_filename, timeout, processes):
         description = test_match.group("description") or "no description"
         ideal = test_match.group("ideal")
         variables = test_match.group("vars")
-        parsed_tests_configs.append((name, description, variables, ideal, exec_filename, timeout))
+        parsed_tests_configs.append((name, description, variables, ideal, exec_filename, timeout, exec_args))
 
     with Pool(processes=processes) as pool:
         all_tests = pool.map(run_test_wrapper, parsed_tests_configs)
@@ -185,5 +120,23 @@ if __name__ == "__main__":
     parser.add_argument("--test_file", help="File with tests", required=True)
     parser.add_argument("--timeout", help="Timeout for one test", default=10.0, type=float)
     parser.add_argument("--processes", help="Ho much processes run", default=1, type=int)
+    parser.add_argument(
+        "--strategy",
+        help="Pair selection strategy passed to the tested program",
+        choices=["fifo", "normal", "sugar", "degree_sugar"],
+        default=None,
+    )
+    parser.add_argument(
+        "--algorithm",
+        help="Groebner basis algorithm passed to the tested program",
+        choices=["buchberger", "f4", "signature", "parallel", "homogenized"],
+        default=None,
+    )
+    parser.add_argument(
+        "--threads",
+        help="Worker threads for the parallel and homogenized algorithms",
+        default=None,
+        type=int,
+    )
     args = parser.parse_args()
-    main(args.exec_file, args.test_file, args.timeout, args.processes)
\ No newline at end of file
+    main(args.exec_file, args.test_file, args.timeout, args.processes, args.strategy, args.algorithm, args.threads)
\ No newline at end of file